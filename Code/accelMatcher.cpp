@@ -0,0 +1,260 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <cstring>
+#include "shuffleMatcher.cpp"
+
+// States that leave their self-loop on at most this many bytes are scanned for those bytes
+#define ACCEL_MAX_ESCAPE_BYTES 3
+// States that loop on fewer bytes than this are not accelerated, their runs are expected to be short
+#define ACCEL_MIN_LOOP_BYTES 128
+
+/**
+ * @brief How an accelerated state finds the end of its self-loop
+ */
+enum accelKind {
+    ACCEL_BYTES,
+    ACCEL_SET
+};
+
+/**
+ * @brief The escape set of an accelerated state: the bytes that leave its self-loop. The two masks hold the set for the vectorized lookup, the bit (b >> 4) & 7 of entry b & 15 of the mask of the half of b
+ */
+struct accelState {
+    accelKind kind;
+    int escape_count;
+    unsigned char escapes[ACCEL_MAX_ESCAPE_BYTES];
+    unsigned char low_mask[16];
+    unsigned char high_mask[16];
+    bool is_escape[256];
+};
+
+#ifdef SHUFFLE_X86
+/**
+ * @brief Finds the first of up to three bytes, 16 bytes at a time
+ * 
+ * @param p The first byte to look at
+ * @param end The end of the bytes
+ * @param escapes The bytes looked for
+ * @param count The number of bytes looked for, from 1 to 3
+ * @return The first byte found, or the start of the last incomplete block of 16 bytes
+ */
+__attribute__((target("sse2")))
+inline const unsigned char* scanForBytes(const unsigned char* p, const unsigned char* end, const unsigned char* escapes, int count) {
+    __m128i e0 = _mm_set1_epi8((char) escapes[0]);
+    __m128i e1 = _mm_set1_epi8((char) escapes[count > 1 ? 1 : 0]);
+    __m128i e2 = _mm_set1_epi8((char) escapes[count > 2 ? 2 : 0]);
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) p);
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, e0), _mm_cmpeq_epi8(v, e1)), _mm_cmpeq_epi8(v, e2));
+        int mask = _mm_movemask_epi8(hit);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return p;
+}
+
+/**
+ * @brief Finds the first byte of a set of any size, 16 bytes at a time. Two pshufb look up the low nibble of every byte in the mask of its half, and a third one picks the bit of its high nibble
+ * 
+ * @param p The first byte to look at
+ * @param end The end of the bytes
+ * @param low_mask The mask of the bytes below 0x80
+ * @param high_mask The mask of the bytes from 0x80 on
+ * @return The first byte found, or the start of the last incomplete block of 16 bytes
+ */
+__attribute__((target("ssse3")))
+inline const unsigned char* scanForByteSet(const unsigned char* p, const unsigned char* end, const unsigned char* low_mask, const unsigned char* high_mask) {
+    __m128i low = _mm_loadu_si128((const __m128i*) low_mask);
+    __m128i high = _mm_loadu_si128((const __m128i*) high_mask);
+    __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i top = _mm_set1_epi8((char) 0x80);
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) p);
+        __m128i row = _mm_or_si128(_mm_shuffle_epi8(low, v), _mm_shuffle_epi8(high, _mm_xor_si128(v, top)));
+        __m128i bit = _mm_shuffle_epi8(bits, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        int mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(row, bit), _mm_setzero_si128())) & 0xFFFF;
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+    return p;
+}
+#endif
+
+/**
+ * @brief A table matcher that crosses the self-loops of its states without stepping through them. Every state that loops on most bytes gets its escape set when it is built: when the walk enters it, the next escape byte is searched with memchr or a vector compare if there are at most three of them, and with a vectorized byte set lookup otherwise, so long runs such as the body of a comment or of a string are read at the speed of the search
+ */
+class AcceleratedMatcher {
+private:
+    TableMatcher matcher;
+    std::vector<int> accel_of_row;
+    std::vector<accelState> states;
+    bool ssse3;
+
+    /**
+     * @brief Skips the bytes that keep an accelerated state in its self-loop
+     * 
+     * @param state The escape set of the state
+     * @param p The first byte to look at
+     * @param end The end of the bytes
+     * @return The first escape byte, or end
+     */
+    const unsigned char* skip(const accelState& state, const unsigned char* p, const unsigned char* end) const {
+        if (state.escape_count == 0) {
+            return end;
+        }
+        if (state.kind == ACCEL_BYTES && state.escape_count == 1) {
+            const void* hit = std::memchr(p, state.escapes[0], end - p);
+            return hit == nullptr ? end : (const unsigned char*) hit;
+        }
+#ifdef SHUFFLE_X86
+        if (state.kind == ACCEL_BYTES) {
+            p = scanForBytes(p, end, state.escapes, state.escape_count);
+        } else if (this->ssse3) {
+            p = scanForByteSet(p, end, state.low_mask, state.high_mask);
+        }
+#endif
+        while (p < end && !state.is_escape[*p]) {
+            p++;
+        }
+        return p;
+    }
+
+    /**
+     * @brief Walks bytes from a row, stopping early at the dead state
+     * 
+     * @param row The row to start from
+     * @param p The first byte
+     * @param end The end of the bytes
+     * @return The row reached
+     */
+    int run(int row, const unsigned char* p, const unsigned char* end) const {
+        const int* table = this->matcher.getTable();
+        const unsigned char* classes = this->matcher.getByteClasses();
+        const int* accel = this->accel_of_row.data();
+        while (p < end && row != 0) {
+            if (accel[row] != NO_STATE) {
+                p = this->skip(this->states[accel[row]], p, end);
+                if (p == end) {
+                    break;
+                }
+            }
+            row = table[row + classes[*p++]];
+        }
+        return row;
+    }
+
+public:
+    // Constructors
+    /**
+     * @brief Finds the escape set of every state of a compiled DFA and picks how to search it
+     * 
+     * @param matcher The compiled DFA
+     */
+    AcceleratedMatcher(const TableMatcher& matcher) {
+        this->matcher = matcher;
+        this->ssse3 = isShuffleSupported();
+        int class_count = matcher.getClassCount();
+        const int* table = matcher.getTable();
+        const unsigned char* classes = matcher.getByteClasses();
+        this->accel_of_row = std::vector<int>((size_t) matcher.getStateCount() * class_count, NO_STATE);
+        for (int s = 1; s < matcher.getStateCount(); s++) {
+            int row = s * class_count;
+            accelState state;
+            std::memset(&state, 0, sizeof(state));
+            for (int b = 0; b < 256; b++) {
+                state.is_escape[b] = table[row + classes[b]] != row;
+                if (!state.is_escape[b]) {
+                    continue;
+                }
+                if (state.escape_count < ACCEL_MAX_ESCAPE_BYTES) {
+                    state.escapes[state.escape_count] = (unsigned char) b;
+                }
+                state.escape_count++;
+                unsigned char* mask = b < 0x80 ? state.low_mask : state.high_mask;
+                mask[b & 0x0F] |= (unsigned char) (1 << ((b >> 4) & 7));
+            }
+            if (256 - state.escape_count < ACCEL_MIN_LOOP_BYTES) {
+                continue;
+            }
+            state.kind = state.escape_count <= ACCEL_MAX_ESCAPE_BYTES ? ACCEL_BYTES : ACCEL_SET;
+            this->accel_of_row[row] = (int) this->states.size();
+            this->states.push_back(state);
+        }
+    }
+
+    // Matching
+    /**
+     * @brief Checks if the DFA accepts a word
+     * 
+     * @param data The bytes of the word
+     * @param length The number of bytes
+     * @return true if the word is accepted. false otherwise
+     */
+    bool matches(const char* data, size_t length) const {
+        const unsigned char* p = (const unsigned char*) data;
+        return this->matcher.isAcceptingRow(this->run(this->matcher.getInitialRow(), p, p + length));
+    }
+
+    /**
+     * @brief Checks if the DFA accepts a word
+     * 
+     * @param word The word
+     * @return true if the word is accepted. false otherwise
+     */
+    bool matches(const std::string& word) const {
+        return this->matches(word.data(), word.size());
+    }
+
+    /**
+     * @brief Walks bytes from a row of the table, stopping early at the dead state
+     * 
+     * @param row The row to start from
+     * @param data The bytes
+     * @param length The number of bytes
+     * @return The row reached
+     */
+    int runFromRow(int row, const char* data, size_t length) const {
+        const unsigned char* p = (const unsigned char*) data;
+        return this->run(row, p, p + length);
+    }
+
+    // AcceleratedMatcher Information
+    /**
+     * @brief Gets the number of accelerated states that search for their escape bytes one by one
+     * 
+     * @return The number of states scanned with memchr or a vector compare
+     */
+    int getByteScanCount() const {
+        int count = 0;
+        for (const accelState& state : this->states) {
+            count += state.kind == ACCEL_BYTES ? 1 : 0;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Gets the number of accelerated states that search for their escape set with the vectorized lookup
+     * 
+     * @return The number of states scanned with the byte set lookup
+     */
+    int getSetScanCount() const {
+        return (int) this->states.size() - this->getByteScanCount();
+    }
+
+    /**
+     * @brief Gets the compiled DFA
+     * 
+     * @return The table matcher
+     */
+    const TableMatcher& getTableMatcher() const {
+        return this->matcher;
+    }
+};
\ No newline at end of file
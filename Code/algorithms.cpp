@@ -3,8 +3,28 @@
  * @author Felipe Nepomuceno Coelho (689661)
  */
 
+#pragma once
+
 #include "superDfa.cpp"
 
+/**
+ * @brief Splits the states of a DFA by finality and label, the partition the algorithms start from. Without labels it is the usual {E - F, F}, so states with different labels are never merged
+ * 
+ * @param dfa The DFA
+ * @return One super state per pair of finality and label
+ */
+std::set<superState> getAcceptanceClasses(DFA dfa) {
+    std::map<std::pair<bool, std::string>, superState> classes;
+    for (state s : dfa.getStates()) {
+        classes[std::make_pair(dfa.isFinalState(s), dfa.getStateLabel(s))].insert(s);
+    }
+    std::set<superState> acceptance_classes;
+    for (std::pair<const std::pair<bool, std::string>, superState> const& it : classes) {
+        acceptance_classes.insert(it.second);
+    }
+    return acceptance_classes;
+}
+
 bool blumWhileCondition(DFA dfa, int t, std::set<std::string> alphabet, superState Q[1024]) {
     for (int i = 1; i <= t; i++) {
         for (std::string a : alphabet) {
@@ -33,11 +53,12 @@ DFA blumOn2Algorithm(DFA dfa) {
     std::cout << "Unreachable states successfully removed.\n";
 
     // Initialization
-    int t = 2;
+    int t = 0;
     superState Q[1024];
     Q[0] = superState();
-    Q[1] = dfa.getFinalStates();
-    Q[2] = dfa.getNonFinalStates();
+    for (superState ss : getAcceptanceClasses(dfa)) {
+        Q[++t] = ss;
+    }
     int i = 1;
     int j = 1;
 
@@ -104,6 +125,13 @@ DFA blumOn2Algorithm(DFA dfa) {
         }
     }
 
+    // Setting up labels
+    for (auto ss : superDfa.getStates()) {
+        if (ss.size() > 0) {
+            superDfa.setStateLabel(ss, dfa.getStateLabel(*ss.begin()));
+        }
+    }
+
     // Setting up transitions (delta')
     for(state q : dfa.getStates()) { // For all q ϵ Q
         for (std::string a : dfa.getAlphabet()) { // For all a ϵ 𝛴
@@ -139,9 +167,8 @@ DFA newtonOn2Algorithm(DFA dfa) {
     dfa.removeUnreachableStates();
     std::cout << "Unreachable states successfully removed.\n";
 
-    if (dfa.getFinalStates().size() <= 0) { // Se F = ∅
-        return dfa; 
-    } else if (dfa.getNonFinalStates().size() <= 0) { // Se E - F = ∅
+    std::set<superState> acceptance_classes = getAcceptanceClasses(dfa);
+    if (acceptance_classes.size() <= 1) { // Se F = ∅ ou E - F = ∅, sem rótulos
         return dfa;
     }
 
@@ -149,8 +176,7 @@ DFA newtonOn2Algorithm(DFA dfa) {
     // Algorithm
     int n = 0; // n <- 0
     std::set<superState> S[1024];
-    S[0].insert(dfa.getNonFinalStates()); // S[0] <- {E - F}
-    S[0].insert(dfa.getFinalStates()); // S[0] <- {E - F, F}
+    S[0] = acceptance_classes; // S[0] <- {E - F, F}, cada um dividido por rótulo
     do { // Repita
         n++; // n <- n + 1
         S[n].clear(); // S[n] <- ∅
@@ -212,6 +238,13 @@ DFA newtonOn2Algorithm(DFA dfa) {
         }
     }
 
+    // Setting up labels
+    for (auto ss : superDfa.getStates()) {
+        if (ss.size() > 0) {
+            superDfa.setStateLabel(ss, dfa.getStateLabel(*ss.begin()));
+        }
+    }
+
     // Setting up transitions (delta')
     for (superState X : S[n]) { // Para cada X ϵ S[n]
         for (std::string a : superDfa.getAlphabet()) { // e a ϵ 𝛴:
@@ -239,7 +272,7 @@ DFA newtonOn2Algorithm(DFA dfa) {
 }
 
 /**
- * @brief Checks if two states are equivalent in a set Q
+ * @brief Checks if two states are equivalent in a set Q. Missing transitions go to the virtual DEAD_STATE, which is in no super state of Q: two DEAD_STATE targets are in the same block, and DEAD_STATE and a real state are in different blocks
  * 
  * @param s1 The first state
  * @param s2 The second state
@@ -252,23 +285,29 @@ bool areEquivalent(state s1, state s2, DFA dfa, std::set<superState> Q) {
         return false;
     } else if (!dfa.isFinalState(s1) && dfa.isFinalState(s2)) {
         return false;
-    } else {
-        for (std::string symbol : dfa.getAlphabet()) {
-            state transitionState1 = dfa.transite(s1,symbol);
-            state transitionState2 = dfa.transite(s2,symbol);
-            // Checking if the transition states are in the same super state of Q
-            for (superState ss : Q) {
-                if (has(ss,transitionState1) && !has(ss,transitionState2)) {
-                    return false;
-                } else if (!has(ss,transitionState1) && has(ss,transitionState2)) {
-                    return false;
-                } else if (has(ss,transitionState1) && has(ss,transitionState2)) {
-                    return true;
-                }
+    }
+    for (std::string symbol : dfa.getAlphabet()) {
+        state transitionState1 = dfa.transite(s1,symbol);
+        state transitionState2 = dfa.transite(s2,symbol);
+        if (transitionState1 == DEAD_STATE || transitionState2 == DEAD_STATE) {
+            if (transitionState1 != transitionState2) {
+                return false;
             }
+            continue;
+        }
+        // Checking if the transition states are in the same super state of Q
+        bool sameSuperState = false;
+        for (superState ss : Q) {
+            if (has(ss,transitionState1)) {
+                sameSuperState = has(ss,transitionState2);
+                break;
+            }
+        }
+        if (!sameSuperState) {
+            return false;
         }
     }
-    return false;
+    return true;
 }
 
 /**
@@ -291,8 +330,7 @@ DFA myOn2Algorithm(DFA dfa) {
     int equivalence = 0;
     std::set<superState> Q[1024];
     Q[equivalence] = std::set<superState>();
-    Q[equivalence].insert(dfa.getNonFinalStates());
-    Q[equivalence].insert(dfa.getFinalStates());
+    Q[equivalence] = getAcceptanceClasses(dfa);
     do {
         equivalence++;
         Q[equivalence] = std::set<superState>();
@@ -386,6 +424,13 @@ DFA myOn2Algorithm(DFA dfa) {
         }
     }
 
+    // Setting up labels
+    for (auto ss : superDfa.getStates()) {
+        if (ss.size() > 0) {
+            superDfa.setStateLabel(ss, dfa.getStateLabel(*ss.begin()));
+        }
+    }
+
     // Setting up transitions (delta')
     for (superState X : Q[equivalence]) {
         for (std::string a : superDfa.getAlphabet()) {
@@ -432,8 +477,7 @@ DFA blumOnLognAlgorithm(DFA dfa) {
     int equivalence = 0;
     std::set<superState> Q[1024];
     Q[equivalence] = std::set<superState>();
-    Q[equivalence].insert(dfa.getNonFinalStates());
-    Q[equivalence].insert(dfa.getFinalStates());
+    Q[equivalence] = getAcceptanceClasses(dfa);
     do {
         equivalence++;
         Q[equivalence] = std::set<superState>();
@@ -527,6 +571,13 @@ DFA blumOnLognAlgorithm(DFA dfa) {
         }
     }
 
+    // Setting up labels
+    for (auto ss : superDfa.getStates()) {
+        if (ss.size() > 0) {
+            superDfa.setStateLabel(ss, dfa.getStateLabel(*ss.begin()));
+        }
+    }
+
     // Setting up transitions (delta')
     for (superState X : Q[equivalence]) {
         for (std::string a : superDfa.getAlphabet()) {
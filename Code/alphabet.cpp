@@ -0,0 +1,146 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include "indexedDfa.cpp"
+
+/**
+ * @brief A partition of the alphabet of a DFA in classes of symbols with identical columns, that is δ(q,a) = δ(q,b) for every state q. Such symbols can never tell two states apart, so an automaton can be minimized over one representative per class and expanded back afterwards.
+ */
+class AlphabetPartition {
+private:
+    std::vector<std::string> symbols;
+    std::vector<int> class_of;
+    std::vector<std::vector<std::string>> members;
+
+public:
+    // Constructors
+    /**
+     * @brief Partitions the alphabet of a DFA by hashing its columns
+     * 
+     * @param dfa The DFA
+     */
+    AlphabetPartition(const IndexedDFA& dfa) {
+        this->symbols = dfa.getSymbols();
+        this->class_of = std::vector<int>(dfa.getSymbolCount());
+        std::vector<int> representative;
+        std::unordered_map<unsigned long long, std::vector<int>> buckets;
+        for (int a = 0; a < dfa.getSymbolCount(); a++) {
+            unsigned long long hash = 14695981039346656037ULL;
+            for (int s = 0; s < dfa.getStateCount(); s++) {
+                hash = (hash ^ (unsigned long long) (dfa.transite(s, a) + 1)) * 1099511628211ULL;
+            }
+            int found = -1;
+            for (int c : buckets[hash]) {
+                bool same = true;
+                for (int s = 0; s < dfa.getStateCount() && same; s++) {
+                    same = dfa.transite(s, a) == dfa.transite(s, representative[c]);
+                }
+                if (same) {
+                    found = c;
+                    break;
+                }
+            }
+            if (found == -1) {
+                found = (int) this->members.size();
+                this->members.push_back(std::vector<std::string>());
+                representative.push_back(a);
+                buckets[hash].push_back(found);
+            }
+            this->class_of[a] = found;
+            this->members[found].push_back(dfa.getSymbol(a));
+        }
+    }
+
+    AlphabetPartition(DFA dfa) : AlphabetPartition(IndexedDFA(dfa)) {}
+
+    // AlphabetPartition Operations
+    /**
+     * @brief Keeps one column per class, named after the first symbol of the class
+     * 
+     * @param dfa The DFA the partition was built from
+     * @return The DFA over the representatives of the classes
+     */
+    IndexedDFA compress(const IndexedDFA& dfa) const {
+        std::vector<std::string> representatives;
+        std::vector<int> columns;
+        for (int a = 0; a < dfa.getSymbolCount(); a++) {
+            if (dfa.getSymbol(a) == this->members[this->class_of[a]][0]) {
+                representatives.push_back(dfa.getSymbol(a));
+                columns.push_back(a);
+            }
+        }
+        IndexedDFA compressed = IndexedDFA(representatives);
+        for (int s = 0; s < dfa.getStateCount(); s++) {
+            compressed.addState(dfa.getStateName(s), dfa.isFinalState(s));
+            compressed.setStateLabel(s, dfa.getStateLabel(s));
+            for (int c = 0; c < (int) columns.size(); c++) {
+                compressed.setTransition(s, c, dfa.transite(s, columns[c]));
+            }
+        }
+        compressed.setInitialState(dfa.getInitialState());
+        return compressed;
+    }
+
+    /**
+     * @brief Keeps one symbol per class in a DFA
+     * 
+     * @param dfa The DFA the partition was built from
+     * @return The DFA over the representatives of the classes, with its reachable states only
+     */
+    DFA compress(DFA dfa) const {
+        return this->compress(IndexedDFA(dfa)).convertToDfa();
+    }
+
+    /**
+     * @brief Restores the whole alphabet in a DFA over the representatives, copying the transitions of each representative to the other symbols of its class
+     * 
+     * @param dfa A DFA over the representatives, e.g. the minimized compressed DFA
+     * @return The DFA over the original alphabet
+     */
+    DFA expand(DFA dfa) const {
+        std::map<std::string, int> class_of_representative;
+        for (int c = 0; c < (int) this->members.size(); c++) {
+            class_of_representative[this->members[c][0]] = c;
+        }
+        DFA expanded = DFA(dfa.getStates(), std::set<std::string>(this->symbols.begin(), this->symbols.end()), std::map<transition, state>(), dfa.getInitialState(), dfa.getFinalStates());
+        for (state s : dfa.getStates()) {
+            expanded.setStateLabel(s, dfa.getStateLabel(s));
+        }
+        for (std::pair<const transition, state> const& it : dfa.getTransitions()) {
+            auto c = class_of_representative.find(it.first.second);
+            if (c == class_of_representative.end()) {
+                expanded.addSymbol(it.first.second);
+                expanded.addTransition(it.first.first, it.first.second, it.second);
+                continue;
+            }
+            for (std::string symbol : this->members[c->second]) {
+                expanded.addTransition(it.first.first, symbol, it.second);
+            }
+        }
+        return expanded;
+    }
+
+    // AlphabetPartition Information
+    /**
+     * @brief Gets the number of classes
+     * 
+     * @return The number of classes
+     */
+    int getClassCount() const {
+        return (int) this->members.size();
+    }
+
+    /**
+     * @brief Gets the number of symbols of the original alphabet
+     * 
+     * @return The number of symbols
+     */
+    int getSymbolCount() const {
+        return (int) this->symbols.size();
+    }
+};
\ No newline at end of file
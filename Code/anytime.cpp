@@ -0,0 +1,481 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+#include <map>
+#include "unionFind.cpp"
+#include "revuz.cpp"
+
+// Number of steps between two checks of the clock and of the cancellation token
+#define ANYTIME_CHECK_INTERVAL 4096
+
+// Fewest steps a pass of walks may take, however many passes in a row merged nothing
+#define ANYTIME_MIN_PASS_STEPS 64
+
+/**
+ * @brief A flag that another thread raises to stop a long computation
+ */
+class CancellationToken {
+private:
+    std::atomic<bool> cancelled;
+
+public:
+    // Constructors
+    CancellationToken() : cancelled(false) {}
+
+    // CancellationToken Operations
+    /**
+     * @brief Asks the computations that watch the token to stop
+     */
+    void cancel() {
+        this->cancelled.store(true);
+    }
+
+    // CancellationToken Information
+    /**
+     * @brief Checks if the computations were asked to stop
+     * 
+     * @return true if the token was cancelled. false otherwise
+     */
+    bool isCancelled() const {
+        return this->cancelled.load();
+    }
+};
+
+/**
+ * @brief Minimizes a DFA in the incremental style of Watson and Daciuk, where states are only merged once they are proven equivalent, so the quotient built at any moment recognizes the language of the DFA and it only gets smaller as the work goes on. The useless states are dropped first and the others are bucketed by their finality and label. The work then alternates between passes of walks and Moore rounds. A pass goes around the states, from where the last one stopped and in the order of their distance to the final and labelled states, so a state usually meets its equivalents once their successors are merged, and compares each one with the states of its bucket already seen in the pass by walking both in lockstep with a union-find of tentative merges (Hopcroft and Karp): a walk that meets no difference proves every pair it merged at once, and a walk that meets one proves that the pair found and all the pairs that led to it are distinguishable, so later walks of the pass stop as soon as they meet one of them. A pass may take as many steps as there are states, half as many as the last pass when that one merged nothing, then a Moore round splits the states of each bucket whose successors are in different buckets, since equivalent states always share them, so the next walks fail sooner. The DFA is minimal when a pass compares every state within its steps, or when a round splits no bucket, as the buckets are then the classes of equivalent states. The work can be split in several runs, each one bounded by a number of steps, a time and a cancellation token.
+ */
+class AnytimeMinimizer {
+private:
+    IndexedDFA dfa;
+    std::vector<int> acceptance;
+    std::vector<bool> useful;
+    int useful_count;
+    std::vector<int> order;
+    UnionFind proven;
+    std::vector<std::vector<int>> buckets;
+    std::vector<int> bucket_of;
+    std::vector<std::vector<int>> next_buckets;
+    std::vector<int> next_bucket_of;
+    std::map<std::vector<int>, int> groups;
+    size_t bucket;
+    size_t member;
+    bool refining;
+    std::unordered_set<unsigned long long> distinguished;
+    std::vector<std::vector<int>> representatives;
+    int cursor;
+    int pass_visits;
+    int pass_merges;
+    unsigned long long pass_limit;
+    unsigned long long pass_steps;
+    size_t representative;
+    unsigned long long steps;
+    int merges;
+    bool complete;
+    std::unordered_map<int, int> tentative;
+    std::vector<std::pair<int, int>> pairs;
+    std::vector<int> parents;
+    size_t walk_position;
+    bool walking;
+
+    /**
+     * @brief Gets the target of a transition, the useless states counting as missing
+     * 
+     * @param s The index of the state
+     * @param a The index of the symbol
+     * @return The index of the target, or NO_STATE
+     */
+    int getTarget(int s, int a) const {
+        int t = this->dfa.transite(s, a);
+        return t == NO_STATE || !this->useful[t] ? NO_STATE : t;
+    }
+
+    /**
+     * @brief Gets the key of an unordered pair of states in the set of distinguishable pairs
+     * 
+     * @param x The first state
+     * @param y The second state
+     * @return The key of the pair
+     */
+    static unsigned long long getPairKey(int x, int y) {
+        return x < y ? ((unsigned long long) x << 32) | (unsigned int) y : ((unsigned long long) y << 32) | (unsigned int) x;
+    }
+
+    /**
+     * @brief Checks if two states are known to be distinguishable, because they are in different buckets or a walk of the pass failed through them
+     * 
+     * @param x The first state
+     * @param y The second state
+     * @return true if the states are distinguishable. false if it is not known
+     */
+    bool areDistinguished(int x, int y) const {
+        return this->bucket_of[x] != this->bucket_of[y] || this->distinguished.count(getPairKey(x, y)) > 0;
+    }
+
+    /**
+     * @brief Ends a failed walk, recording as distinguishable the pair where it failed and every pair that led to it
+     * 
+     * @param position The position of the failed pair in the walk
+     */
+    void failWalk(int position) {
+        for (int i = position; i != NO_STATE; i = this->parents[i]) {
+            this->distinguished.insert(getPairKey(this->pairs[i].first, this->pairs[i].second));
+        }
+        this->walking = false;
+    }
+
+    /**
+     * @brief Starts a pass of walks over the current buckets, from the state where the last pass stopped. It may take as many steps as there are states, or half as many as the last pass when that one merged nothing
+     */
+    void startPass() {
+        this->refining = false;
+        this->representatives.assign(this->buckets.size(), std::vector<int>());
+        this->distinguished.clear();
+        if (this->pass_merges > 0 || this->pass_limit == 0) {
+            this->pass_limit = (unsigned long long) this->useful_count;
+        } else {
+            this->pass_limit = std::max(this->pass_limit / 2, (unsigned long long) ANYTIME_MIN_PASS_STEPS);
+        }
+        this->pass_visits = 0;
+        this->pass_merges = 0;
+        this->pass_steps = this->pass_limit;
+        this->representative = 0;
+        this->walking = false;
+    }
+
+    /**
+     * @brief Moves the next state of the current Moore round to the new bucket of its old bucket and successor buckets. A bucket with a single state is moved as a whole. When the round ends, a new pass starts if it split some bucket, and otherwise the states of each bucket are merged
+     */
+    void refineStep() {
+        const std::vector<int>& states = this->buckets[this->bucket];
+        if (states.size() == 1) {
+            this->next_bucket_of[states[0]] = (int) this->next_buckets.size();
+            this->next_buckets.push_back(states);
+            this->member = states.size();
+        } else {
+            int s = states[this->member];
+            std::vector<int> key(this->dfa.getSymbolCount());
+            for (int a = 0; a < this->dfa.getSymbolCount(); a++) {
+                int t = this->getTarget(s, a);
+                key[a] = t == NO_STATE ? NO_STATE : this->bucket_of[t];
+            }
+            auto it = this->groups.find(key);
+            if (it == this->groups.end()) {
+                it = this->groups.insert(std::make_pair(key, (int) this->next_buckets.size())).first;
+                this->next_buckets.push_back(std::vector<int>());
+            }
+            this->next_buckets[it->second].push_back(s);
+            this->next_bucket_of[s] = it->second;
+            this->member++;
+        }
+        if (this->member < states.size()) {
+            return;
+        }
+        this->groups.clear();
+        this->bucket++;
+        this->member = 0;
+        if (this->bucket < this->buckets.size()) {
+            return;
+        }
+        bool split = this->next_buckets.size() != this->buckets.size();
+        this->buckets.swap(this->next_buckets);
+        this->bucket_of.swap(this->next_bucket_of);
+        this->next_buckets.clear();
+        this->bucket = 0;
+        if (split) {
+            this->startPass();
+            return;
+        }
+        for (const std::vector<int>& members : this->buckets) {
+            for (int s : members) {
+                if (this->proven.unite(members[0], s)) {
+                    this->merges++;
+                }
+            }
+        }
+        this->refining = false;
+        this->complete = true;
+    }
+
+    /**
+     * @brief Gets the representative of a state among the proven and the tentative merges
+     * 
+     * @param s The index of the state
+     * @return The representative
+     */
+    int findTentative(int s) {
+        s = this->proven.find(s);
+        auto it = this->tentative.find(s);
+        while (it != this->tentative.end()) {
+            s = it->second;
+            it = this->tentative.find(s);
+        }
+        return s;
+    }
+
+    /**
+     * @brief Starts walking two states in lockstep
+     * 
+     * @param p The first state
+     * @param q The second state
+     */
+    void startWalk(int p, int q) {
+        this->tentative.clear();
+        this->pairs.assign(1, std::make_pair(p, q));
+        this->parents.assign(1, NO_STATE);
+        this->tentative[this->proven.find(q)] = this->proven.find(p);
+        this->walk_position = 0;
+        this->walking = true;
+    }
+
+    /**
+     * @brief Goes on with the walk, merging tentatively every pair met. A walk stopped by the budget resumes where it stopped
+     * 
+     * @param budget The largest number of pairs to visit
+     * @param visited Receives the number of pairs visited
+     * @return 1 if the states are equivalent, 0 if they are not, -1 if the budget ran out first
+     */
+    int continueWalk(unsigned long long budget, unsigned long long* visited) {
+        *visited = 0;
+        int k = this->dfa.getSymbolCount();
+        for (; this->walk_position < this->pairs.size(); this->walk_position++) {
+            if (*visited == budget) {
+                return -1;
+            }
+            ++*visited;
+            int x = this->pairs[this->walk_position].first;
+            int y = this->pairs[this->walk_position].second;
+            if (this->acceptance[x] != this->acceptance[y] || this->areDistinguished(x, y)) {
+                this->failWalk((int) this->walk_position);
+                return 0;
+            }
+            for (int a = 0; a < k; a++) {
+                int tx = this->getTarget(x, a);
+                int ty = this->getTarget(y, a);
+                if ((tx == NO_STATE) != (ty == NO_STATE)) {
+                    this->failWalk((int) this->walk_position);
+                    return 0;
+                }
+                if (tx == NO_STATE) {
+                    continue;
+                }
+                int rx = this->findTentative(tx);
+                int ry = this->findTentative(ty);
+                if (rx != ry) {
+                    this->tentative[ry] = rx;
+                    this->pairs.push_back(std::make_pair(tx, ty));
+                    this->parents.push_back((int) this->walk_position);
+                }
+            }
+        }
+        this->walking = false;
+        return 1;
+    }
+
+    /**
+     * @brief Moves the pass to the next state. The minimization is complete once the pass has been around every state
+     */
+    void advanceCursor() {
+        this->cursor = (this->cursor + 1) % this->useful_count;
+        this->representative = 0;
+        this->pass_visits++;
+        if (this->pass_visits == this->useful_count) {
+            this->complete = true;
+        }
+    }
+
+    /**
+     * @brief Goes on with the pass: skips the state under the cursor when it is merged, keeps it as a representative of its bucket once it was compared with every other one, or goes on walking it with the next representative. A walk that succeeds merges its pairs right away. When the steps of the pass run out, the walk is dropped and a Moore round starts
+     * 
+     * @param budget The largest number of steps to take
+     * @return The number of steps taken
+     */
+    unsigned long long walkStep(unsigned long long budget) {
+        if (this->pass_steps == 0) {
+            this->walking = false;
+            this->refining = true;
+            return 0;
+        }
+        int s = this->order[this->cursor];
+        if (!this->walking) {
+            this->pass_steps--;
+            if (this->proven.find(s) != s) {
+                this->advanceCursor();
+                return 1;
+            }
+            std::vector<int>& reps = this->representatives[this->bucket_of[s]];
+            while (this->representative < reps.size() && this->proven.find(reps[this->representative]) != reps[this->representative]) {
+                this->representative++;
+            }
+            if (this->representative >= reps.size()) {
+                reps.push_back(s);
+                this->advanceCursor();
+                return 1;
+            }
+            this->startWalk(reps[this->representative], s);
+            return 1;
+        }
+        unsigned long long visited = 0;
+        int result = this->continueWalk(std::min(budget, this->pass_steps), &visited);
+        this->pass_steps -= visited;
+        if (result == 1) {
+            for (std::pair<int, int> pair : this->pairs) {
+                if (this->proven.unite(pair.first, pair.second)) {
+                    this->merges++;
+                    this->pass_merges++;
+                }
+            }
+            this->advanceCursor();
+        } else if (result == 0) {
+            this->representative++;
+        }
+        return visited;
+    }
+
+public:
+    // Constructors
+    /**
+     * @brief Prepares the minimization, which drops the useless states, buckets the others and orders them for the passes by a backward search from the final and labelled states
+     * 
+     * @param dfa The DFA, with only reachable states
+     */
+    AnytimeMinimizer(const IndexedDFA& dfa) : proven(dfa.getStateCount()) {
+        this->dfa = dfa;
+        this->acceptance = getAcceptanceLabels(dfa);
+        this->useful = findUsefulStates(dfa);
+        this->useful_count = 0;
+        this->bucket_of = std::vector<int>(dfa.getStateCount(), NO_STATE);
+        std::vector<int> number(dfa.getStateCount() + 2, NO_STATE);
+        std::vector<std::vector<int>> predecessors(dfa.getStateCount());
+        for (int s = 0; s < dfa.getStateCount(); s++) {
+            if (!this->useful[s]) {
+                continue;
+            }
+            if (number[this->acceptance[s]] == NO_STATE) {
+                number[this->acceptance[s]] = (int) this->buckets.size();
+                this->buckets.push_back(std::vector<int>());
+            }
+            this->bucket_of[s] = number[this->acceptance[s]];
+            this->buckets[this->bucket_of[s]].push_back(s);
+            this->useful_count++;
+            for (int a = 0; a < dfa.getSymbolCount(); a++) {
+                int t = this->getTarget(s, a);
+                if (t != NO_STATE) {
+                    predecessors[t].push_back(s);
+                }
+            }
+            if (dfa.isFinalState(s) || dfa.getStateLabel(s) != "") {
+                this->order.push_back(s);
+            }
+        }
+        std::vector<bool> ordered(dfa.getStateCount(), false);
+        for (int s : this->order) {
+            ordered[s] = true;
+        }
+        for (size_t i = 0; i < this->order.size(); i++) {
+            for (int p : predecessors[this->order[i]]) {
+                if (!ordered[p]) {
+                    ordered[p] = true;
+                    this->order.push_back(p);
+                }
+            }
+        }
+        this->next_bucket_of = this->bucket_of;
+        this->bucket = 0;
+        this->member = 0;
+        this->cursor = 0;
+        this->pass_merges = 0;
+        this->pass_limit = 0;
+        this->steps = 0;
+        this->merges = 0;
+        this->complete = this->useful_count == 0;
+        this->walk_position = 0;
+        this->startPass();
+    }
+
+    // AnytimeMinimizer Operations
+    /**
+     * @brief Goes on with the minimization until it is complete, a budget runs out or the token is cancelled. It may be called again to resume
+     * 
+     * @param max_steps The largest number of steps of this run: states moved by the refinement, states visited by the passes and pairs of states visited by the walks
+     * @param max_time The longest time this run may take
+     * @param token A token to stop the run, or nullptr
+     * @return true if the minimization is complete. false otherwise
+     */
+    bool run(unsigned long long max_steps, std::chrono::nanoseconds max_time, const CancellationToken* token) {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + max_time;
+        unsigned long long run_steps = 0;
+        unsigned long long next_check = ANYTIME_CHECK_INTERVAL;
+        while (!this->complete) {
+            if (run_steps >= max_steps) {
+                return false;
+            }
+            if (run_steps >= next_check) {
+                next_check = run_steps + ANYTIME_CHECK_INTERVAL;
+                if (std::chrono::steady_clock::now() >= deadline || (token != nullptr && token->isCancelled())) {
+                    return false;
+                }
+            }
+            unsigned long long taken = 1;
+            if (this->refining) {
+                this->refineStep();
+            } else {
+                taken = this->walkStep(std::min(max_steps, next_check) - run_steps);
+            }
+            run_steps += taken;
+            this->steps += taken;
+        }
+        return true;
+    }
+
+    // AnytimeMinimizer Information
+    /**
+     * @brief Builds the quotient of the DFA by the merges proven so far. It recognizes the language of the DFA whenever it is called, and it is minimal once the minimization is complete
+     * 
+     * @return The quotient DFA, its states named after the first member of their class
+     */
+    IndexedDFA getResult() {
+        int n = this->dfa.getStateCount();
+        std::vector<int> classes(n + 1);
+        for (int s = 0; s < n; s++) {
+            classes[s] = this->useful[s] ? this->proven.find(s) : n;
+        }
+        classes[n] = n;
+        return buildIndexedQuotient(this->dfa, classes);
+    }
+
+    /**
+     * @brief Checks if every state was compared, so the result is minimal
+     * 
+     * @return true if the minimization is complete. false otherwise
+     */
+    bool isComplete() const {
+        return this->complete;
+    }
+
+    /**
+     * @brief Gets the number of steps made so far, over all the runs
+     * 
+     * @return The number of steps
+     */
+    unsigned long long getSteps() const {
+        return this->steps;
+    }
+
+    /**
+     * @brief Gets the number of states the current result has
+     * 
+     * @return The number of states of the quotient, the useless ones not counted
+     */
+    int getClassCount() const {
+        return this->useful_count - this->merges;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,298 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include "nfa.cpp"
+#include "partition.cpp"
+
+/**
+ * @brief The bisimulation reductions that can run on an NFA before determinization
+ */
+enum bisimulationMode {
+    BISIMULATION_NONE,
+    BISIMULATION_FORWARD,
+    BISIMULATION_FORWARD_BACKWARD
+};
+
+/**
+ * @brief Computes the coarsest forward bisimulation of an NFA with the Paige–Tarjan algorithm, in O(m log n) for m transitions. Two states are bisimilar when they have the same label and, for every symbol (ε included), each one reaches a class the other also reaches. Besides the partition of the states, the algorithm keeps a coarser partition of compound blocks that the states are already stable with, and refines with the smaller half of a compound block, counting for every state how many of its transitions go into each compound block to find the states that only reach the other half
+ * 
+ * @param nfa The NFA
+ * @param labels One label per state. States with different labels are never merged
+ * @return The class of each state, numbered from 0 in order of first appearance
+ */
+std::vector<int> computeBisimulationClasses(const NFA& nfa, const std::vector<int>& labels) {
+    int n = nfa.getStateCount();
+    int k = nfa.getSymbolCount() + 1;
+    int epsilon = k - 1;
+
+    // Transitions, ε using the last symbol index, and one counter per (state, symbol, compound block) they go into
+    std::vector<int> edge_from, edge_symbol, edge_to, edge_counter;
+    std::vector<int> counters;
+    for (int p = 0; p < n; p++) {
+        const std::vector<std::pair<int, int>>& moves = nfa.getMoves(p);
+        for (size_t i = 0; i < moves.size(); i++) {
+            if (i == 0 || moves[i].first != moves[i - 1].first) {
+                counters.push_back(0);
+            }
+            edge_from.push_back(p);
+            edge_symbol.push_back(moves[i].first);
+            edge_to.push_back(moves[i].second);
+            edge_counter.push_back((int) counters.size() - 1);
+            counters.back()++;
+        }
+        if (nfa.getEpsilonMoves(p).size() > 0) {
+            counters.push_back((int) nfa.getEpsilonMoves(p).size());
+        }
+        for (int q : nfa.getEpsilonMoves(p)) {
+            edge_from.push_back(p);
+            edge_symbol.push_back(epsilon);
+            edge_to.push_back(q);
+            edge_counter.push_back((int) counters.size() - 1);
+        }
+    }
+    int m = (int) edge_from.size();
+
+    // Inverse transitions: the transitions into q are incoming[incoming_start[q] .. incoming_start[q+1])
+    std::vector<int> incoming_start(n + 1, 0);
+    for (int e = 0; e < m; e++) {
+        incoming_start[edge_to[e] + 1]++;
+    }
+    for (int q = 0; q < n; q++) {
+        incoming_start[q + 1] += incoming_start[q];
+    }
+    std::vector<int> incoming(m);
+    std::vector<int> fill(incoming_start.begin(), incoming_start.end() - 1);
+    for (int e = 0; e < m; e++) {
+        incoming[fill[edge_to[e]]++] = e;
+    }
+
+    // Compound blocks: the blocks of each one, the compound block of each block and the compound blocks with two or more blocks
+    RefinablePartition partition = RefinablePartition(labels);
+    std::vector<std::vector<int>> compound_blocks(1);
+    std::vector<int> compound_of, position;
+    std::vector<int> worklist;
+    std::vector<bool> in_worklist(1, false);
+    auto addBlock = [&](int block, int compound) {
+        compound_of.resize(std::max((int) compound_of.size(), block + 1));
+        position.resize(compound_of.size());
+        compound_of[block] = compound;
+        position[block] = (int) compound_blocks[compound].size();
+        compound_blocks[compound].push_back(block);
+        if (compound_blocks[compound].size() >= 2 && !in_worklist[compound]) {
+            worklist.push_back(compound);
+            in_worklist[compound] = true;
+        }
+    };
+    std::vector<std::pair<int, int>> splits;
+    auto splitMarked = [&]() {
+        partition.split(splits);
+        for (std::pair<int, int> split : splits) {
+            addBlock(split.second, compound_of[split.first]);
+        }
+    };
+    for (int b = 0; b < partition.getBlockCount(); b++) {
+        addBlock(b, 0);
+    }
+
+    // Stabilizing with the single compound block of all states: splitting by having or not a transition with each symbol
+    std::vector<std::vector<int>> edges_by_symbol(k);
+    for (int e = 0; e < m; e++) {
+        edges_by_symbol[edge_symbol[e]].push_back(e);
+    }
+    for (int a = 0; a < k; a++) {
+        for (int e : edges_by_symbol[a]) {
+            partition.mark(edge_from[e]);
+        }
+        splitMarked();
+        edges_by_symbol[a].clear();
+    }
+
+    std::vector<int> splitter;
+    std::vector<int> used_symbols;
+    std::vector<int> count_in_block(n, 0);
+    std::vector<int> counter_of(n, 0);
+    std::vector<int> new_counter(n, 0);
+    while (worklist.size() > 0) {
+        int S = worklist.back();
+        if (compound_blocks[S].size() < 2) {
+            worklist.pop_back();
+            in_worklist[S] = false;
+            continue;
+        }
+
+        // Taking the smaller of two blocks of S out into a compound block of its own
+        std::vector<int>& blocks = compound_blocks[S];
+        int B = partition.getBlockSize(blocks[0]) <= partition.getBlockSize(blocks[1]) ? blocks[0] : blocks[1];
+        position[blocks.back()] = position[B];
+        blocks[position[B]] = blocks.back();
+        blocks.pop_back();
+        if (blocks.size() < 2) {
+            worklist.pop_back();
+            in_worklist[S] = false;
+        }
+        compound_blocks.push_back(std::vector<int>());
+        in_worklist.push_back(false);
+        addBlock(B, (int) compound_blocks.size() - 1);
+
+        // Grouping the transitions into B by symbol
+        splitter.assign(partition.getBlockBegin(B), partition.getBlockEnd(B));
+        used_symbols.clear();
+        for (int q : splitter) {
+            for (int i = incoming_start[q]; i < incoming_start[q + 1]; i++) {
+                int e = incoming[i];
+                if (edges_by_symbol[edge_symbol[e]].size() == 0) {
+                    used_symbols.push_back(edge_symbol[e]);
+                }
+                edges_by_symbol[edge_symbol[e]].push_back(e);
+            }
+        }
+
+        for (int a : used_symbols) {
+            std::vector<int>& edges = edges_by_symbol[a];
+
+            // The states with a transition into B
+            for (int e : edges) {
+                count_in_block[edge_from[e]]++;
+                counter_of[edge_from[e]] = edge_counter[e];
+                partition.mark(edge_from[e]);
+            }
+            splitMarked();
+
+            // The states whose transitions into S all go into B
+            for (int e : edges) {
+                int p = edge_from[e];
+                if (count_in_block[p] == counters[counter_of[p]]) {
+                    partition.mark(p);
+                }
+            }
+            splitMarked();
+
+            // Moving the counts of the transitions into B to counters of their own
+            for (int e : edges) {
+                int p = edge_from[e];
+                if (count_in_block[p] > 0) {
+                    counters[counter_of[p]] -= count_in_block[p];
+                    new_counter[p] = (int) counters.size();
+                    counters.push_back(count_in_block[p]);
+                    count_in_block[p] = 0;
+                }
+                edge_counter[e] = new_counter[p];
+            }
+            edges.clear();
+        }
+    }
+
+    return partition.getClasses();
+}
+
+/**
+ * @brief Reverses the transitions of an NFA and swaps its initial and final states
+ * 
+ * @param nfa The NFA
+ * @return The reversed NFA, which accepts the reversed words
+ */
+NFA reverseNfa(const NFA& nfa) {
+    NFA reversed = NFA(nfa.getSymbols());
+    std::vector<bool> initial(nfa.getStateCount(), false);
+    for (int s : nfa.getInitialStates()) {
+        initial[s] = true;
+    }
+    for (int s = 0; s < nfa.getStateCount(); s++) {
+        reversed.addState(nfa.getStateName(s), initial[s]);
+    }
+    for (int s = 0; s < nfa.getStateCount(); s++) {
+        if (nfa.isFinalState(s)) {
+            reversed.addInitialState(s);
+        }
+        for (std::pair<int, int> move : nfa.getMoves(s)) {
+            reversed.addTransition(move.second, move.first, s);
+        }
+        for (int t : nfa.getEpsilonMoves(s)) {
+            reversed.addTransition(t, EPSILON, s);
+        }
+    }
+    return reversed;
+}
+
+/**
+ * @brief Merges the states of each class of an NFA into a single state, named after its first member. A merged state is initial or final when one of its members is, and takes the label determinize would give to the set of its members
+ * 
+ * @param nfa The NFA
+ * @param classes The class of each state, numbered from 0
+ * @return The quotient NFA
+ */
+NFA buildNfaQuotient(const NFA& nfa, const std::vector<int>& classes) {
+    NFA quotient = NFA(nfa.getSymbols());
+    for (const std::string& name : nfa.getLabelNames()) {
+        quotient.addLabel(name);
+    }
+    std::vector<int> number(nfa.getStateCount(), NO_STATE);
+    for (int s = 0; s < nfa.getStateCount(); s++) {
+        if (number[classes[s]] == NO_STATE) {
+            number[classes[s]] = quotient.addState(nfa.getStateName(s), false);
+        }
+        if (nfa.isFinalState(s)) {
+            quotient.setFinalState(number[classes[s]], true);
+        }
+    }
+    if (nfa.hasLabels()) {
+        std::vector<int> final_label(quotient.getStateCount(), NO_LABEL);
+        std::vector<int> any_label(quotient.getStateCount(), NO_LABEL);
+        for (int s = 0; s < nfa.getStateCount(); s++) {
+            int q = number[classes[s]];
+            int label = nfa.getStateLabel(s);
+            if (label != NO_LABEL && nfa.isFinalState(s) && (final_label[q] == NO_LABEL || label < final_label[q])) {
+                final_label[q] = label;
+            }
+            if (label != NO_LABEL && (any_label[q] == NO_LABEL || label < any_label[q])) {
+                any_label[q] = label;
+            }
+        }
+        for (int q = 0; q < quotient.getStateCount(); q++) {
+            quotient.setStateLabel(q, quotient.isFinalState(q) ? final_label[q] : any_label[q]);
+        }
+    }
+    for (int s : nfa.getInitialStates()) {
+        quotient.addInitialState(number[classes[s]]);
+    }
+    for (int s = 0; s < nfa.getStateCount(); s++) {
+        for (std::pair<int, int> move : nfa.getMoves(s)) {
+            quotient.addTransition(number[classes[s]], move.first, number[classes[move.second]]);
+        }
+        for (int t : nfa.getEpsilonMoves(s)) {
+            if (classes[t] != classes[s]) {
+                quotient.addTransition(number[classes[s]], EPSILON, number[classes[t]]);
+            }
+        }
+    }
+    return quotient;
+}
+
+/**
+ * @brief Shrinks an NFA before determinization by merging bisimilar states. The forward reduction merges states with the same finality, the same label and the same future; the backward one, run afterwards on the reversed NFA, merges states with the same initiality and the same past, which are always in the same sets during determinization, so their merged label is the one the set would get anyway. Both keep the language and the labels of the determinized DFA
+ * 
+ * @param nfa The NFA
+ * @param backward Whether the backward reduction also runs
+ * @return The reduced NFA
+ */
+NFA reduceByBisimulation(const NFA& nfa, bool backward) {
+    std::vector<int> labels(nfa.getStateCount());
+    for (int s = 0; s < nfa.getStateCount(); s++) {
+        labels[s] = nfa.getStateLabel(s) * 2 + (nfa.isFinalState(s) ? 1 : 0);
+    }
+    NFA reduced = buildNfaQuotient(nfa, computeBisimulationClasses(nfa, labels));
+    if (!backward) {
+        return reduced;
+    }
+
+    NFA reversed = reverseNfa(reduced);
+    labels.assign(reversed.getStateCount(), 0);
+    for (int s : reduced.getInitialStates()) {
+        labels[s] = 1;
+    }
+    return buildNfaQuotient(reduced, computeBisimulationClasses(reversed, labels));
+}
\ No newline at end of file
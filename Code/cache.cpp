@@ -0,0 +1,347 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include "indexedDfa.cpp"
+
+/**
+ * @brief The bookkeeping of one file of the minimization cache
+ */
+struct cacheEntry {
+    unsigned long long bytes;
+    unsigned long long last_used;
+};
+
+/**
+ * @brief A content-addressed disk cache of minimization results. The key of a DFA is the hash of its canonical form (see IndexedDFA), so the same automaton with other state names hits the same entry. The least recently used entries are evicted when the cache goes over its limits.
+ */
+class MinimizationCache {
+private:
+    std::string directory;
+    size_t max_entries;
+    unsigned long long max_bytes;
+    std::map<std::string, cacheEntry> entries;
+    unsigned long long clock;
+    int hits;
+    int misses;
+
+    /**
+     * @brief Gets the path of the index file
+     * 
+     * @return The path of the index file
+     */
+    std::string getIndexPath() {
+        return this->directory + "index.txt";
+    }
+
+    /**
+     * @brief Gets the path of the file of an entry
+     * 
+     * @param key The key of the entry
+     * @return The path of the entry file
+     */
+    std::string getEntryPath(std::string key) {
+        return this->directory + key + ".min";
+    }
+
+    /**
+     * @brief Reads the index file, which has one "key bytes last_used" line per entry
+     */
+    void loadIndex() {
+        std::ifstream index(this->getIndexPath());
+        std::string key;
+        cacheEntry entry;
+        while (index >> key >> entry.bytes >> entry.last_used) {
+            if (!existsFile(this->getEntryPath(key))) {
+                continue;
+            }
+            this->entries[key] = entry;
+            this->clock = std::max(this->clock, entry.last_used);
+        }
+    }
+
+    /**
+     * @brief Writes the index file
+     */
+    void saveIndex() {
+        std::ofstream index(this->getIndexPath());
+        for (std::pair<const std::string, cacheEntry> const& it : this->entries) {
+            index << it.first << " " << it.second.bytes << " " << it.second.last_used << "\n";
+        }
+    }
+
+    /**
+     * @brief Removes the least recently used entries until the cache is within its limits
+     */
+    void evict() {
+        unsigned long long total_bytes = 0;
+        for (std::pair<const std::string, cacheEntry> const& it : this->entries) {
+            total_bytes += it.second.bytes;
+        }
+        while (this->entries.size() > 0 && (this->entries.size() > this->max_entries || total_bytes > this->max_bytes)) {
+            auto oldest = this->entries.begin();
+            for (auto it = this->entries.begin(); it != this->entries.end(); it++) {
+                if (it->second.last_used < oldest->second.last_used) {
+                    oldest = it;
+                }
+            }
+            total_bytes -= oldest->second.bytes;
+            std::remove(this->getEntryPath(oldest->first).c_str());
+            this->entries.erase(oldest);
+        }
+    }
+
+    /**
+     * @brief Computes the key of a DFA for a given algorithm
+     * 
+     * @param canonical The serialized canonical form of the DFA
+     * @param algorithm The name of the minimization algorithm
+     * @return The key, as an hexadecimal string
+     */
+    std::string getKey(std::string canonical, std::string algorithm) {
+        char key[17];
+        snprintf(key, sizeof(key), "%016llx", fnv1aHash(algorithm + "\n" + canonical));
+        return std::string(key);
+    }
+
+    /**
+     * @brief Gets the check written in an entry to tell hash collisions apart
+     * 
+     * @param canonical The serialized canonical form of the DFA
+     * @return The check
+     */
+    std::string getCheck(std::string canonical) {
+        return std::to_string(canonical.size()) + " " + std::to_string(fnv1aHash(canonical, 1099511628211ULL));
+    }
+
+    /**
+     * @brief Writes a minimized DFA as the partition of the canonical states of its input. Each line holds a block: its final flag, its transitions (block indexes) and the canonical states inside it. The first block is the initial one.
+     * 
+     * @param input The canonical form of the DFA that was minimized
+     * @param result The minimized DFA
+     * @param text Where the compact form is written
+     * @return true if the result could be written. false if its states are not unions of input states
+     */
+    bool encodeResult(IndexedDFA& input, DFA result, std::string* text) {
+        std::map<state, int> canonical_ids;
+        for (int s = 0; s < input.getStateCount(); s++) {
+            canonical_ids[input.getStateName(s)] = s;
+        }
+
+        IndexedDFA blocks = IndexedDFA(result);
+        if (blocks.getSymbols() != input.getSymbols() || blocks.getStateCount() != (int) result.getStates().size()) {
+            return false;
+        }
+
+        std::ostringstream out;
+        out << blocks.getStateCount() << "\n";
+        for (int b = 0; b < blocks.getStateCount(); b++) {
+            std::vector<int> members;
+            std::stringstream name(blocks.getStateName(b));
+            std::string s;
+            while (std::getline(name, s, ',')) {
+                if (canonical_ids.find(s) == canonical_ids.end()) {
+                    return false;
+                }
+                members.push_back(canonical_ids[s]);
+            }
+            if (members.size() == 0) {
+                return false;
+            }
+            out << (blocks.isFinalState(b) ? 1 : 0);
+            for (int a = 0; a < blocks.getSymbolCount(); a++) {
+                out << " " << blocks.transite(b, a);
+            }
+            out << " " << members.size();
+            for (int m : members) {
+                out << " " << m;
+            }
+            out << "\n";
+        }
+        *text = out.str();
+        return true;
+    }
+
+    /**
+     * @brief Rebuilds a minimized DFA from its compact form, naming each block after the states of the current input, just like SuperDFA::convertToDfa does, and labelling it like its members
+     * 
+     * @param input The canonical form of the DFA being minimized
+     * @param in The stream positioned on the compact form
+     * @param result Where the minimized DFA is written
+     * @return true if the entry could be read. false otherwise
+     */
+    bool decodeResult(IndexedDFA& input, std::istream& in, DFA* result) {
+        int block_count;
+        if (!(in >> block_count) || block_count <= 0) {
+            return false;
+        }
+
+        std::vector<std::string> names(block_count);
+        std::vector<std::string> labels(block_count);
+        std::vector<bool> finals(block_count);
+        std::vector<std::vector<int>> rows(block_count, std::vector<int>(input.getSymbolCount()));
+        for (int b = 0; b < block_count; b++) {
+            int is_final;
+            size_t member_count;
+            in >> is_final;
+            finals[b] = is_final == 1;
+            for (int a = 0; a < input.getSymbolCount(); a++) {
+                in >> rows[b][a];
+                if (rows[b][a] < NO_STATE || rows[b][a] >= block_count) {
+                    return false;
+                }
+            }
+            in >> member_count;
+            if (!in || member_count == 0) {
+                return false;
+            }
+            std::set<state> members;
+            for (size_t i = 0; i < member_count; i++) {
+                int m;
+                in >> m;
+                if (!in || m < 0 || m >= input.getStateCount()) {
+                    return false;
+                }
+                members.insert(input.getStateName(m));
+                labels[b] = input.getStateLabel(m);
+            }
+            for (state s : members) {
+                names[b] += (s + ",");
+            }
+            names[b].pop_back();
+        }
+        if (!in) {
+            return false;
+        }
+
+        DFA dfa = DFA();
+        for (std::string symbol : input.getSymbols()) {
+            dfa.addSymbol(symbol);
+        }
+        for (int b = 0; b < block_count; b++) {
+            dfa.addState(names[b]);
+            if (finals[b]) {
+                dfa.addFinalState(names[b]);
+            }
+            dfa.setStateLabel(names[b], labels[b]);
+            for (int a = 0; a < input.getSymbolCount(); a++) {
+                if (rows[b][a] != NO_STATE) {
+                    dfa.addTransition(names[b], input.getSymbol(a), names[rows[b][a]]);
+                }
+            }
+        }
+        dfa.setInitialState(names[0]);
+        *result = dfa;
+        return true;
+    }
+
+public:
+    // Constructors
+    /**
+     * @brief Opens (or creates) a cache in a directory
+     * 
+     * @param directory The directory where the cache files are kept, ending with a slash
+     * @param max_entries The maximum number of cached results
+     * @param max_bytes The maximum total size of the cached results
+     */
+    MinimizationCache(std::string directory, size_t max_entries, unsigned long long max_bytes) {
+        this->directory = directory;
+        this->max_entries = max_entries;
+        this->max_bytes = max_bytes;
+        this->entries = std::map<std::string, cacheEntry>();
+        this->clock = 0;
+        this->hits = 0;
+        this->misses = 0;
+        createDirectory(directory);
+        this->loadIndex();
+    }
+
+    // Cache Operations
+    /**
+     * @brief Minimizes a DFA, skipping the minimization when an equal automaton was already minimized by the same algorithm
+     * 
+     * @param dfa The DFA to be minimized
+     * @param minimizer The minimization algorithm
+     * @param algorithm A name identifying the algorithm in the cache
+     * @return The minimized DFA
+     */
+    DFA minimize(DFA dfa, DFA (*minimizer)(DFA), std::string algorithm) {
+        IndexedDFA input = IndexedDFA(dfa);
+        std::string canonical = input.serialize();
+        std::string key = this->getKey(canonical, algorithm);
+        std::string check = this->getCheck(canonical);
+
+        if (this->entries.find(key) != this->entries.end()) {
+            std::ifstream file(this->getEntryPath(key));
+            std::string entry_check;
+            std::getline(file, entry_check);
+            DFA result;
+            if (entry_check == check && this->decodeResult(input, file, &result)) {
+                this->hits++;
+                this->entries[key].last_used = ++this->clock;
+                this->saveIndex();
+                std::cout << "Cache hit, minimization skipped.\n";
+                return result;
+            }
+        }
+
+        this->misses++;
+        DFA result = minimizer(dfa);
+        std::string text;
+        if (this->encodeResult(input, result, &text)) {
+            text = check + "\n" + text;
+            std::ofstream file(this->getEntryPath(key));
+            file << text;
+            file.close();
+            this->entries[key] = cacheEntry{(unsigned long long) text.size(), ++this->clock};
+            this->evict();
+            this->saveIndex();
+        }
+        return result;
+    }
+
+    /**
+     * @brief Removes every entry of the cache
+     */
+    void clear() {
+        for (std::pair<const std::string, cacheEntry> const& it : this->entries) {
+            std::remove(this->getEntryPath(it.first).c_str());
+        }
+        this->entries.clear();
+        this->saveIndex();
+    }
+
+    // Cache Information
+    /**
+     * @brief Gets the number of minimizations skipped by this cache
+     * 
+     * @return The number of hits
+     */
+    int getHits() {
+        return this->hits;
+    }
+
+    /**
+     * @brief Gets the number of minimizations that had to run
+     * 
+     * @return The number of misses
+     */
+    int getMisses() {
+        return this->misses;
+    }
+
+    /**
+     * @brief Gets the number of results stored in the cache
+     * 
+     * @return The number of entries
+     */
+    int getEntryCount() {
+        return (int) this->entries.size();
+    }
+};
\ No newline at end of file
@@ -0,0 +1,192 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <sstream>
+#include <cctype>
+#include <set>
+#include "matcher.cpp"
+
+/**
+ * @brief The styles of generated matchers
+ */
+enum codegenStyle {
+    CODEGEN_TABLE,
+    CODEGEN_SWITCH
+};
+
+/**
+ * @brief Checks if a word is a C++ keyword or alternative token, which cannot be used as an identifier
+ * 
+ * @param word The word
+ * @return true if the word is reserved by the language. false otherwise
+ */
+bool isCppKeyword(const std::string& word) {
+    static const std::set<std::string> keywords = {
+        "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch",
+        "char", "char8_t", "char16_t", "char32_t", "class", "compl", "concept", "const", "consteval", "constexpr",
+        "constinit", "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype", "default", "delete",
+        "do", "double", "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for",
+        "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq",
+        "nullptr", "operator", "or", "or_eq", "private", "protected", "public", "register", "reinterpret_cast",
+        "requires", "return", "short", "signed", "sizeof", "static", "static_assert", "static_cast", "struct",
+        "switch", "template", "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename",
+        "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq"
+    };
+    return keywords.count(word) > 0;
+}
+
+/**
+ * @brief Turns a name into a valid C++ identifier that is not reserved: keywords, names starting with a digit or an underscore and names with a double underscore get a prefix or lose the extra underscores
+ * 
+ * @param name The name
+ * @return The name with every invalid character replaced by an underscore, runs of underscores merged and "dfa_" in front when needed
+ */
+std::string toIdentifier(std::string name) {
+    std::string identifier = "";
+    for (char c : name) {
+        char valid = std::isalnum((unsigned char) c) ? c : '_';
+        if (valid != '_' || identifier.size() == 0 || identifier.back() != '_') {
+            identifier += valid;
+        }
+    }
+    if (identifier.size() == 0 || std::isdigit((unsigned char) identifier[0]) || isCppKeyword(identifier)) {
+        identifier = "dfa_" + identifier;
+    } else if (identifier[0] == '_') {
+        identifier = "dfa" + identifier;
+    }
+    return identifier;
+}
+
+/**
+ * @brief Writes a byte as a C++ character literal when it is printable, as a number otherwise
+ * 
+ * @param b The byte
+ * @return The literal
+ */
+std::string toByteLiteral(int b) {
+    if (b >= 32 && b < 127 && b != '\'' && b != '\\') {
+        return std::string("'") + (char) b + "'";
+    }
+    return std::to_string(b);
+}
+
+/**
+ * @brief Writes the constexpr table style: the byte classes, the transition table and a match function walking it
+ * 
+ * @param matcher The compiled DFA
+ * @param out Where the code is written
+ */
+void generateTableMatcher(const TableMatcher& matcher, std::ostringstream& out) {
+    int n = matcher.getStateCount();
+    int class_count = matcher.getClassCount();
+    std::string type = n <= 256 ? "unsigned char" : n <= 65536 ? "unsigned short" : "unsigned int";
+
+    out << "constexpr unsigned char byte_class[256] = {";
+    for (int b = 0; b < 256; b++) {
+        out << (b % 16 == 0 ? "\n    " : " ") << (int) matcher.getByteClasses()[b] << ",";
+    }
+    out << "\n};\n\n";
+
+    out << "constexpr " << type << " transitions[" << n << "][" << class_count << "] = {\n";
+    for (int s = 0; s < n; s++) {
+        out << "    {";
+        for (int c = 0; c < class_count; c++) {
+            out << (c > 0 ? ", " : "") << matcher.getTable()[s * class_count + c] / class_count;
+        }
+        out << "},\n";
+    }
+    out << "};\n\n";
+
+    out << "constexpr bool accepting[" << n << "] = {";
+    for (int s = 0; s < n; s++) {
+        out << (s > 0 ? ", " : "") << (matcher.isAcceptingRow(s * class_count) ? "true" : "false");
+    }
+    out << "};\n\n";
+
+    out << "constexpr int initial_state = " << matcher.getInitialRow() / class_count << ";\n";
+    out << "constexpr int dead_state = 0;\n\n";
+
+    out << "constexpr bool match(const char* data, std::size_t length) {\n";
+    out << "    int s = initial_state;\n";
+    out << "    for (std::size_t i = 0; i < length && s != dead_state; i++) {\n";
+    out << "        s = transitions[s][byte_class[(unsigned char) data[i]]];\n";
+    out << "    }\n";
+    out << "    return accepting[s];\n";
+    out << "}\n";
+}
+
+/**
+ * @brief Writes the direct-coded style: one label per state and a switch on the next byte that jumps to the next state
+ * 
+ * @param matcher The compiled DFA
+ * @param out Where the code is written
+ */
+void generateSwitchMatcher(const TableMatcher& matcher, std::ostringstream& out) {
+    int n = matcher.getStateCount();
+    int class_count = matcher.getClassCount();
+
+    out << "inline bool match(const char* data, std::size_t length) {\n";
+    if (matcher.getInitialRow() == 0) {
+        out << "    (void) data;\n";
+        out << "    (void) length;\n";
+        out << "    return false;\n";
+        out << "}\n";
+        return;
+    }
+    out << "    const unsigned char* p = (const unsigned char*) data;\n";
+    out << "    const unsigned char* end = p + length;\n";
+    out << "    goto state_" << matcher.getInitialRow() / class_count << ";\n";
+    for (int s = 1; s < n; s++) {
+        out << "state_" << s << ":\n";
+        out << "    if (p == end) {\n";
+        out << "        return " << (matcher.isAcceptingRow(s * class_count) ? "true" : "false") << ";\n";
+        out << "    }\n";
+        out << "    switch (*p++) {\n";
+        std::map<int, std::vector<int>> bytes_by_target;
+        for (int b = 0; b < 256; b++) {
+            int target = matcher.getTable()[s * class_count + matcher.getByteClasses()[b]] / class_count;
+            if (target != 0) {
+                bytes_by_target[target].push_back(b);
+            }
+        }
+        for (std::pair<const int, std::vector<int>> const& it : bytes_by_target) {
+            out << "   ";
+            for (int b : it.second) {
+                out << " case " << toByteLiteral(b) << ":";
+            }
+            out << "\n        goto state_" << it.first << ";\n";
+        }
+        out << "    default:\n";
+        out << "        return false;\n";
+        out << "    }\n";
+    }
+    out << "}\n";
+}
+
+/**
+ * @brief Generates a self-contained C++ header with a matcher for a DFA. Every symbol must be a single byte
+ * 
+ * @param dfa The DFA, usually minimized
+ * @param name The name of the namespace holding the matcher
+ * @param style The style of the matcher
+ * @return The content of the header
+ */
+std::string generateCppHeader(DFA dfa, std::string name, codegenStyle style) {
+    TableMatcher matcher = TableMatcher(dfa);
+    std::ostringstream out;
+    out << "// Generated DFA matcher: " << matcher.getStateCount() << " states (state 0 is the dead state), " << matcher.getClassCount() << " byte classes.\n";
+    out << "#pragma once\n\n";
+    out << "#include <cstddef>\n\n";
+    out << "namespace " << toIdentifier(name) << " {\n\n";
+    if (style == CODEGEN_TABLE) {
+        generateTableMatcher(matcher, out);
+    } else {
+        generateSwitchMatcher(matcher, out);
+    }
+    out << "\n} // namespace " << toIdentifier(name) << "\n";
+    return out.str();
+}
\ No newline at end of file
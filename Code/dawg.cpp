@@ -0,0 +1,357 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include "indexedDfa.cpp"
+
+// The first bytes of a binary DAWG file
+#define DAWG_MAGIC "DAWG"
+
+/**
+ * @brief Builds the minimal DFA of a sorted list of words incrementally, with the algorithm of Daciuk, Mihov, Watson and Watson (2000). Only the path of the last word is not minimal yet: when a new word arrives, the part of that path it does not share is compared bottom-up with a register of the minimized states, and each state is either replaced by an equivalent one of the register or added to it. The automaton is minimal after every word, so the memory stays proportional to the minimal DFA plus the length of a word. Every symbol is a single byte.
+ */
+class DawgBuilder {
+private:
+    std::vector<std::vector<std::pair<unsigned char, int>>> edges;
+    std::vector<bool> final_states;
+    std::vector<int> free_states;
+    std::unordered_multimap<unsigned long long, int> registry;
+    std::vector<int> path;
+    std::string last_word;
+    size_t word_count;
+    size_t transition_count;
+    int live_states;
+    int peak_states;
+    bool finished;
+
+    /**
+     * @brief Creates a state without transitions, reusing a freed one when there is any
+     * 
+     * @return The index of the state
+     */
+    int newState() {
+        int s;
+        if (this->free_states.size() > 0) {
+            s = this->free_states.back();
+            this->free_states.pop_back();
+        } else {
+            s = (int) this->edges.size();
+            this->edges.push_back(std::vector<std::pair<unsigned char, int>>());
+            this->final_states.push_back(false);
+        }
+        this->live_states++;
+        this->peak_states = std::max(this->peak_states, this->live_states);
+        return s;
+    }
+
+    /**
+     * @brief Frees a state that was replaced by an equivalent one
+     * 
+     * @param s The index of the state
+     */
+    void freeState(int s) {
+        this->transition_count -= this->edges[s].size();
+        this->edges[s].clear();
+        this->final_states[s] = false;
+        this->free_states.push_back(s);
+        this->live_states--;
+    }
+
+    /**
+     * @brief Hashes the finality and the transitions of a state
+     * 
+     * @param s The index of the state
+     * @return The hash of the state
+     */
+    unsigned long long hash(int s) const {
+        unsigned long long h = 14695981039346656037ULL ^ (this->final_states[s] ? 1 : 0);
+        for (std::pair<unsigned char, int> edge : this->edges[s]) {
+            h = (h ^ edge.first) * 1099511628211ULL;
+            h = (h ^ (unsigned) edge.second) * 1099511628211ULL;
+        }
+        return h;
+    }
+
+    /**
+     * @brief Minimizes the path of the last word below a given depth, from its end upwards. The states below the path are all in the register already, so two states are equivalent exactly when they have the same finality and the same transitions
+     * 
+     * @param depth The number of leading states of the path that are kept as they are
+     */
+    void minimizePath(size_t depth) {
+        while (this->path.size() > depth + 1) {
+            int s = this->path.back();
+            this->path.pop_back();
+            unsigned long long h = this->hash(s);
+            int equivalent = NO_STATE;
+            auto range = this->registry.equal_range(h);
+            for (auto it = range.first; it != range.second; it++) {
+                if (this->final_states[it->second] == this->final_states[s] && this->edges[it->second] == this->edges[s]) {
+                    equivalent = it->second;
+                    break;
+                }
+            }
+            if (equivalent == NO_STATE) {
+                this->registry.emplace(h, s);
+            } else {
+                this->edges[this->path.back()].back().second = equivalent;
+                this->freeState(s);
+            }
+        }
+    }
+
+public:
+    // Constructors
+    DawgBuilder() {
+        this->word_count = 0;
+        this->transition_count = 0;
+        this->live_states = 0;
+        this->peak_states = 0;
+        this->finished = false;
+        this->path.push_back(this->newState());
+    }
+
+    // DawgBuilder Operations
+    /**
+     * @brief Adds a word, which must not come before the previous one in byte order. A repeated word is ignored
+     * 
+     * @param word The word
+     */
+    void addWord(const std::string& word) {
+        if (this->finished) {
+            throw std::runtime_error("No word can be added after the automaton is finished.");
+        }
+        if (this->word_count > 0 && word <= this->last_word) {
+            if (word == this->last_word) {
+                return;
+            }
+            throw std::invalid_argument("The words are not sorted: \"" + word + "\" comes after \"" + this->last_word + "\".");
+        }
+        size_t prefix = 0;
+        while (prefix < word.size() && prefix < this->last_word.size() && word[prefix] == this->last_word[prefix]) {
+            prefix++;
+        }
+        this->minimizePath(prefix);
+        for (size_t i = prefix; i < word.size(); i++) {
+            int s = this->newState();
+            this->edges[this->path.back()].push_back(std::make_pair((unsigned char) word[i], s));
+            this->transition_count++;
+            this->path.push_back(s);
+        }
+        this->final_states[this->path.back()] = true;
+        this->last_word = word;
+        this->word_count++;
+    }
+
+    /**
+     * @brief Minimizes what is left of the path of the last word and renumbers the states from 0, the initial state first, in BFS order
+     */
+    void finish() {
+        if (this->finished) {
+            return;
+        }
+        this->minimizePath(0);
+        this->registry.clear();
+        this->free_states.clear();
+
+        std::vector<int> number(this->edges.size(), NO_STATE);
+        std::vector<int> order(1, this->path[0]);
+        number[this->path[0]] = 0;
+        for (size_t i = 0; i < order.size(); i++) {
+            for (std::pair<unsigned char, int> edge : this->edges[order[i]]) {
+                if (number[edge.second] == NO_STATE) {
+                    number[edge.second] = (int) order.size();
+                    order.push_back(edge.second);
+                }
+            }
+        }
+        std::vector<std::vector<std::pair<unsigned char, int>>> renumbered(order.size());
+        std::vector<bool> renumbered_final(order.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            renumbered[i].swap(this->edges[order[i]]);
+            for (std::pair<unsigned char, int>& edge : renumbered[i]) {
+                edge.second = number[edge.second];
+            }
+            renumbered_final[i] = this->final_states[order[i]];
+        }
+        this->edges.swap(renumbered);
+        this->final_states.swap(renumbered_final);
+        this->path.assign(1, 0);
+        this->live_states = (int) order.size();
+        this->finished = true;
+    }
+
+    /**
+     * @brief Writes the finished automaton in a binary form: the magic bytes, the number of states and, for every state, its finality, its number of transitions and each transition as a byte and a target, the numbers as 32 bit integers in the byte order of the machine. State 0 is the initial state
+     * 
+     * @param output The stream to write to
+     */
+    void writeBinary(std::ostream& output) const {
+        unsigned int n = (unsigned int) this->edges.size();
+        output.write(DAWG_MAGIC, 4);
+        output.write((const char*) &n, sizeof(n));
+        for (unsigned int s = 0; s < n; s++) {
+            char is_final = this->final_states[s] ? 1 : 0;
+            unsigned int count = (unsigned int) this->edges[s].size();
+            output.write(&is_final, 1);
+            output.write((const char*) &count, sizeof(count));
+            for (std::pair<unsigned char, int> edge : this->edges[s]) {
+                output.write((const char*) &edge.first, 1);
+                output.write((const char*) &edge.second, sizeof(edge.second));
+            }
+        }
+    }
+
+    // DawgBuilder Information
+    /**
+     * @brief Gets the transitions of a state of the finished automaton
+     * 
+     * @param s The index of the state
+     * @return The (byte, target) pairs, sorted by byte
+     */
+    const std::vector<std::pair<unsigned char, int>>& getEdges(int s) const {
+        return this->edges[s];
+    }
+
+    /**
+     * @brief Checks if a state is final
+     * 
+     * @param s The index of the state
+     * @return true if the state is final. false otherwise
+     */
+    bool isFinalState(int s) const {
+        return this->final_states[s];
+    }
+
+    /**
+     * @brief Gets the number of states in use
+     * 
+     * @return The number of states
+     */
+    int getStateCount() const {
+        return this->live_states;
+    }
+
+    /**
+     * @brief Gets the largest number of states in use at any time, which bounds the memory used
+     * 
+     * @return The peak number of states
+     */
+    int getPeakStateCount() const {
+        return this->peak_states;
+    }
+
+    /**
+     * @brief Gets the number of transitions in use
+     * 
+     * @return The number of transitions
+     */
+    size_t getTransitionCount() const {
+        return this->transition_count;
+    }
+
+    /**
+     * @brief Gets the number of distinct words added
+     * 
+     * @return The number of words
+     */
+    size_t getWordCount() const {
+        return this->word_count;
+    }
+
+    /**
+     * @brief Convert the finished automaton to an IndexedDFA over the bytes it reads, with states named by their numbers
+     * 
+     * @return The minimal DFA of the words
+     */
+    IndexedDFA convertToIndexedDfa() const {
+        int symbol_of[256];
+        std::fill(symbol_of, symbol_of + 256, NO_STATE);
+        for (const std::vector<std::pair<unsigned char, int>>& list : this->edges) {
+            for (std::pair<unsigned char, int> edge : list) {
+                symbol_of[edge.first] = 0;
+            }
+        }
+        std::vector<std::string> symbols;
+        for (int b = 0; b < 256; b++) {
+            if (symbol_of[b] != NO_STATE) {
+                symbol_of[b] = (int) symbols.size();
+                symbols.push_back(std::string(1, (char) b));
+            }
+        }
+        IndexedDFA dfa = IndexedDFA(symbols);
+        for (size_t s = 0; s < this->edges.size(); s++) {
+            dfa.addState(std::to_string(s), this->final_states[s]);
+        }
+        for (size_t s = 0; s < this->edges.size(); s++) {
+            for (std::pair<unsigned char, int> edge : this->edges[s]) {
+                dfa.setTransition((int) s, symbol_of[edge.first], edge.second);
+            }
+        }
+        dfa.setInitialState(0);
+        return dfa;
+    }
+};
+
+/**
+ * @brief Reads an automaton written by DawgBuilder::writeBinary
+ * 
+ * @param file_path The path of the file
+ * @param dfa Where the DFA is written
+ * @return true if the file was read. false if it does not exist or is not in the binary form
+ */
+bool readDawgBinary(std::string file_path, IndexedDFA* dfa) {
+    std::ifstream input(file_path, std::ios::binary);
+    char magic[4];
+    unsigned int n = 0;
+    if (!input.read(magic, 4) || std::string(magic, 4) != DAWG_MAGIC || !input.read((char*) &n, sizeof(n))) {
+        return false;
+    }
+    std::vector<std::vector<std::pair<unsigned char, int>>> edges(n);
+    std::vector<bool> final_states(n);
+    int symbol_of[256];
+    std::fill(symbol_of, symbol_of + 256, NO_STATE);
+    for (unsigned int s = 0; s < n; s++) {
+        char is_final = 0;
+        unsigned int count = 0;
+        if (!input.read(&is_final, 1) || !input.read((char*) &count, sizeof(count))) {
+            return false;
+        }
+        final_states[s] = is_final != 0;
+        edges[s].resize(count);
+        for (std::pair<unsigned char, int>& edge : edges[s]) {
+            if (!input.read((char*) &edge.first, 1) || !input.read((char*) &edge.second, sizeof(edge.second)) || edge.second < 0 || (unsigned int) edge.second >= n) {
+                return false;
+            }
+            symbol_of[edge.first] = 0;
+        }
+    }
+
+    std::vector<std::string> symbols;
+    for (int b = 0; b < 256; b++) {
+        if (symbol_of[b] != NO_STATE) {
+            symbol_of[b] = (int) symbols.size();
+            symbols.push_back(std::string(1, (char) b));
+        }
+    }
+    *dfa = IndexedDFA(symbols);
+    for (unsigned int s = 0; s < n; s++) {
+        dfa->addState(std::to_string(s), final_states[s]);
+    }
+    for (unsigned int s = 0; s < n; s++) {
+        for (std::pair<unsigned char, int> edge : edges[s]) {
+            dfa->setTransition((int) s, symbol_of[edge.first], edge.second);
+        }
+    }
+    if (n > 0) {
+        dfa->setInitialState(0);
+    }
+    return true;
+}
\ No newline at end of file
@@ -3,17 +3,23 @@
  * @author Felipe Nepomuceno Coelho (689661)
  */
 
+#pragma once
+
 #include <set>
 #include <map>
 #include <utility>
 #include <iostream>
+#include <cstdlib>
 #include "utils.cpp"
 
 typedef std::string state;
 typedef std::pair<state, std::string> transition;
 
+// The virtual dead state. transite returns it for missing transitions, it is never stored, it is not final and every symbol leads back to it
+#define DEAD_STATE ""
+
 /**
- * @brief A class representing a Deterministic Finite Automaton
+ * @brief A class representing a Deterministic Finite Automaton. Only the existing transitions are stored, the missing ones go to the virtual DEAD_STATE, so a DFA is always complete without materializing a sink state
  */
 class DFA {
 private:
@@ -22,6 +28,7 @@ private:
     std::map<transition, state> transitions;
     state initial_state;
     std::set<state> final_states;
+    std::map<state, std::string> labels;
 
 public:
     // Constructors
@@ -31,6 +38,7 @@ public:
         this->transitions = std::map<transition, state>();
         this->initial_state = "";
         this->final_states = std::set<state>();
+        this->labels = std::map<state, std::string>();
     }
 
     DFA(std::set<state> states,
@@ -69,9 +77,13 @@ public:
      * 
      * @param from The state from which the transition starts
      * @param read The symbol that triggers the transition
-     * @param to The state to which the transition goes
+     * @param to The state to which the transition goes. DEAD_STATE removes the transition
      */
     void addTransition(state from, std::string read, state to) {
+        if (to == DEAD_STATE) {
+            this->transitions.erase(std::make_pair(from, read));
+            return;
+        }
         this->transitions[std::make_pair(from, read)] = to;
     }
 
@@ -93,6 +105,20 @@ public:
         this->final_states.insert(s);
     }
 
+    /**
+     * @brief Sets the label of a state, such as the token type of a lexer state. States with different labels are never merged by a minimization
+     * 
+     * @param s The state
+     * @param label The label, or an empty string to remove it
+     */
+    void setStateLabel(state s, std::string label) {
+        if (label == "") {
+            this->labels.erase(s);
+            return;
+        }
+        this->labels[s] = label;
+    }
+
     // DFA Information
     /**
      * @brief Checks if a state is a final state
@@ -104,6 +130,26 @@ public:
         return this->final_states.find(s) != this->final_states.end();
     }
 
+    /**
+     * @brief Gets the label of a state
+     * 
+     * @param s The state
+     * @return The label of the state, or an empty string if it has none
+     */
+    std::string getStateLabel(state s) {
+        auto it = this->labels.find(s);
+        return it == this->labels.end() ? "" : it->second;
+    }
+
+    /**
+     * @brief Checks if any state has a label
+     * 
+     * @return true if some state is labelled. false otherwise
+     */
+    bool hasLabels() {
+        return this->labels.size() > 0;
+    }
+
     /**
      * @brief Gets the DFA's initial state
      * 
@@ -142,10 +188,22 @@ public:
      * 
      * @param from The state from which the transition starts
      * @param read The symbol that triggers the transition
-     * @return The state to which the transition goes
+     * @return The state to which the transition goes, or DEAD_STATE if there is no such transition
      */
     state transite(state from, std::string read) {
-        return this->transitions[std::make_pair(from, read)];
+        auto it = this->transitions.find(std::make_pair(from, read));
+        return it == this->transitions.end() ? DEAD_STATE : it->second;
+    }
+
+    /**
+     * @brief Checks if there is a transition leaving a state with a symbol
+     * 
+     * @param from The state from which the transition starts
+     * @param read The symbol that triggers the transition
+     * @return true if the transition exists. false otherwise
+     */
+    bool hasTransition(state from, std::string read) {
+        return this->transitions.find(std::make_pair(from, read)) != this->transitions.end();
     }
 
     /**
@@ -189,7 +247,7 @@ public:
             for (state s : new_reachable_states) {
                 for (std::string symbol : this->alphabet) {
                     state next_state = this->transite(s, symbol);
-                    if (!has(reachable_states,next_state)) {
+                    if (next_state != DEAD_STATE && !has(reachable_states,next_state)) {
                         aux.insert(next_state);
                     }
                 }
@@ -205,6 +263,8 @@ public:
         }
         for (state s : unreachable_states) {
             this->states.erase(s);
+            this->final_states.erase(s);
+            this->labels.erase(s);
             for (std::string symbol : this->alphabet) {
                 this->transitions.erase(std::make_pair(s, symbol));
             }
@@ -212,28 +272,45 @@ public:
     }
 
     /**
-     * @brief Complete the DFA
+     * @brief Complete the DFA, turning the virtual dead state into a real error state. The other operations already treat missing transitions as going to DEAD_STATE, so this is only needed when the error state must be a real one, e.g. an accepting one in a complement
+     * 
+     * @return The error state, or DEAD_STATE if no transition was missing
      */
-    void completeAutomaton() {
-        int error_state_value = 0;
-        for (state s : this->getStates()) {
-            try {
-                if (std::stoi(s) > error_state_value) {
-                    error_state_value = std::stoi(s);
-                }
-            } catch (std::exception& e) {
-                continue;
+    state completeAutomaton() {
+        size_t missing = this->states.size() * this->alphabet.size();
+        for (std::pair<const transition, state> const& it : this->transitions) {
+            if (has(this->states, it.first.first) && has(this->alphabet, it.first.second)) {
+                missing--;
             }
         }
-        error_state_value++;
-        state error_state = std::to_string(error_state_value);
-        this->addState(error_state);
-        for (state s : this->getStates()) {
-            for (std::string symbol : this->getAlphabet()) {
-                if (this->transitions.find(std::make_pair(s, symbol)) == this->transitions.end()) {
+        if (missing == 0) {
+            return DEAD_STATE;
+        }
+
+        // The error state is numbered after the largest numeric state, like the ids of a JFLAP file
+        long long error_state_value = 0;
+        for (state s : this->states) {
+            char* end = nullptr;
+            long long value = std::strtoll(s.c_str(), &end, 10);
+            if (s.size() > 0 && *end == '\0' && value > error_state_value) {
+                error_state_value = value;
+            }
+        }
+        state error_state = std::to_string(error_state_value + 1);
+        while (has(this->states, error_state)) {
+            error_state = "_" + error_state;
+        }
+        for (state s : this->states) {
+            for (std::string symbol : this->alphabet) {
+                if (!this->hasTransition(s, symbol)) {
                     this->addTransition(s, symbol, error_state);
                 }
             }
         }
+        this->addState(error_state);
+        for (std::string symbol : this->alphabet) {
+            this->addTransition(error_state, symbol, error_state);
+        }
+        return error_state;
     }
 };
\ No newline at end of file
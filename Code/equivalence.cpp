@@ -0,0 +1,253 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include "indexedDfa.cpp"
+#include "unionFind.cpp"
+
+/**
+ * @brief Two DFAs seen as one automaton over the union of their alphabets. The states of the first DFA come first, followed by its dead state, then the states of the second DFA and its dead state. Missing transitions and symbols that a DFA does not know go to its dead state.
+ */
+class PairedDFA {
+private:
+    IndexedDFA dfas[2];
+    std::vector<std::string> symbols;
+    std::vector<int> columns[2];
+    int offsets[2];
+
+public:
+    // Constructors
+    PairedDFA(DFA dfa1, DFA dfa2) : PairedDFA(IndexedDFA(dfa1), IndexedDFA(dfa2)) {}
+
+    PairedDFA(const IndexedDFA& dfa1, const IndexedDFA& dfa2) {
+        this->dfas[0] = dfa1;
+        this->dfas[1] = dfa2;
+        std::set<std::string> alphabet;
+        for (int i = 0; i < 2; i++) {
+            alphabet.insert(this->dfas[i].getSymbols().begin(), this->dfas[i].getSymbols().end());
+        }
+        this->symbols = std::vector<std::string>(alphabet.begin(), alphabet.end());
+        for (int i = 0; i < 2; i++) {
+            for (std::string symbol : this->symbols) {
+                this->columns[i].push_back(this->dfas[i].getSymbolIndex(symbol));
+            }
+        }
+        this->offsets[0] = 0;
+        this->offsets[1] = this->dfas[0].getStateCount() + 1;
+    }
+
+    // PairedDFA Information
+    /**
+     * @brief Gets the total number of states, dead states included
+     * 
+     * @return The number of states
+     */
+    int getStateCount() {
+        return this->offsets[1] + this->dfas[1].getStateCount() + 1;
+    }
+
+    /**
+     * @brief Gets the joined alphabet
+     * 
+     * @return The sorted symbols of both DFAs
+     */
+    const std::vector<std::string>& getSymbols() {
+        return this->symbols;
+    }
+
+    /**
+     * @brief Gets the initial state of one of the DFAs
+     * 
+     * @param i 0 for the first DFA, 1 for the second
+     * @return The initial state, or the dead state if the DFA has no initial state
+     */
+    int getInitialState(int i) {
+        int initial = this->dfas[i].getInitialState();
+        return this->offsets[i] + (initial == NO_STATE ? this->dfas[i].getStateCount() : initial);
+    }
+
+    /**
+     * @brief Gets the dead state of one of the DFAs
+     * 
+     * @param i 0 for the first DFA, 1 for the second
+     * @return The dead state
+     */
+    int getDeadState(int i) {
+        return this->offsets[i] + this->dfas[i].getStateCount();
+    }
+
+    /**
+     * @brief Gets the index of the first state of one of the DFAs. The state s of that DFA is the state s + offset here
+     * 
+     * @param i 0 for the first DFA, 1 for the second
+     * @return The offset of the DFA
+     */
+    int getOffset(int i) {
+        return this->offsets[i];
+    }
+
+    /**
+     * @brief Gets one of the DFAs, with its own numbering
+     * 
+     * @param i 0 for the first DFA, 1 for the second
+     * @return The DFA
+     */
+    const IndexedDFA& getDfa(int i) {
+        return this->dfas[i];
+    }
+
+    /**
+     * @brief Gets the state reached from a state reading a symbol of the joined alphabet
+     * 
+     * @param s The state
+     * @param a The index of the symbol in the joined alphabet
+     * @return The next state
+     */
+    int transite(int s, int a) {
+        int i = s >= this->offsets[1] ? 1 : 0;
+        int local = s - this->offsets[i];
+        int dead = this->dfas[i].getStateCount();
+        if (local == dead || this->columns[i][a] < 0) {
+            return this->offsets[i] + dead;
+        }
+        int next = this->dfas[i].transite(local, this->columns[i][a]);
+        return this->offsets[i] + (next == NO_STATE ? dead : next);
+    }
+
+    /**
+     * @brief Checks if a state is final
+     * 
+     * @param s The state
+     * @return true if the state is final. false otherwise
+     */
+    bool isFinalState(int s) {
+        int i = s >= this->offsets[1] ? 1 : 0;
+        int local = s - this->offsets[i];
+        return local < this->dfas[i].getStateCount() && this->dfas[i].isFinalState(local);
+    }
+};
+
+/**
+ * @brief A pair of states waiting to be compared, with the way it was reached
+ */
+struct pairRecord {
+    int p;
+    int q;
+    int parent;
+    int symbol;
+};
+
+/**
+ * @brief Finds a shortest word that leads only one of two states of a PairedDFA to a final state, with the Hopcroft-Karp algorithm. Pairs of states are visited in BFS order and merged in a union-find, so each merge is done once, the total work is near-linear and at most one pair per merge is kept. A pair skipped because its states were already merged cannot hide a shorter word, since the pairs that merged them were reached no later and one of them is told apart by the same suffix
+ * 
+ * @param paired The states of the DFAs
+ * @param p The first state
+ * @param q The second state
+ * @param word If not null and the states are distinguishable, receives a shortest distinguishing word
+ * @return true if the states are distinguishable. false if they accept the same words
+ */
+bool findShortestDistinguishingWord(PairedDFA& paired, int p, int q, std::vector<std::string>* word) {
+    UnionFind sets = UnionFind(paired.getStateCount());
+    std::vector<pairRecord> records;
+
+    // The queue is the tail of records, the head is the next pair to be compared
+    records.push_back(pairRecord{p, q, -1, -1});
+    sets.unite(p, q);
+    for (size_t head = 0; head < records.size(); head++) {
+        pairRecord current = records[head];
+        if (paired.isFinalState(current.p) != paired.isFinalState(current.q)) {
+            if (word != nullptr) {
+                word->clear();
+                for (int r = (int) head; records[r].parent != -1; r = records[r].parent) {
+                    word->push_back(paired.getSymbols()[records[r].symbol]);
+                }
+                std::reverse(word->begin(), word->end());
+            }
+            return true;
+        }
+        for (int a = 0; a < (int) paired.getSymbols().size(); a++) {
+            int next_p = paired.transite(current.p, a);
+            int next_q = paired.transite(current.q, a);
+            if (sets.unite(next_p, next_q)) {
+                records.push_back(pairRecord{next_p, next_q, (int) head, a});
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Checks if two DFAs accept the same language by searching a word that tells their initial states apart. Neither DFA is minimized.
+ * 
+ * @param dfa1 The first DFA
+ * @param dfa2 The second DFA
+ * @param counterexample If not null and the DFAs are not equivalent, receives a shortest word accepted by only one of them
+ * @return true if the DFAs are equivalent. false otherwise
+ */
+bool checkEquivalence(DFA dfa1, DFA dfa2, std::vector<std::string>* counterexample) {
+    PairedDFA paired = PairedDFA(dfa1, dfa2);
+    return !findShortestDistinguishingWord(paired, paired.getInitialState(0), paired.getInitialState(1), counterexample);
+}
+
+/**
+ * @brief Finds a shortest word that tells apart two states of an IndexedDFA, without going through the DFA class, so large automata can be queried many times
+ * 
+ * @param dfa The DFA
+ * @param p The index of the first state
+ * @param q The index of the second state
+ * @param word If not null and the states are distinguishable, receives a shortest distinguishing word
+ * @return true if the states are distinguishable. false if they are equivalent
+ */
+bool findDistinguishingWord(const IndexedDFA& dfa, int p, int q, std::vector<std::string>* word) {
+    PairedDFA paired = PairedDFA(dfa, IndexedDFA(dfa.getSymbols()));
+    return findShortestDistinguishingWord(paired, p, q, word);
+}
+
+/**
+ * @brief Finds a shortest word that tells apart a state of a DFA and a state of another DFA, a word that leads only one of them to a final state
+ * 
+ * @param dfa1 The DFA of the first state
+ * @param p The first state
+ * @param dfa2 The DFA of the second state
+ * @param q The second state
+ * @param word If not null and the states are distinguishable, receives a shortest distinguishing word
+ * @return true if the states are distinguishable. false if they accept the same words
+ */
+bool findDistinguishingWord(DFA dfa1, state p, DFA dfa2, state q, std::vector<std::string>* word) {
+    dfa1.setInitialState(p);
+    dfa2.setInitialState(q);
+    return !checkEquivalence(dfa1, dfa2, word);
+}
+
+/**
+ * @brief Finds a shortest word that tells apart two states of a DFA
+ * 
+ * @param dfa The DFA
+ * @param p The first state
+ * @param q The second state
+ * @param word If not null and the states are distinguishable, receives a shortest distinguishing word
+ * @return true if the states are distinguishable. false if they are equivalent
+ */
+bool findDistinguishingWord(DFA dfa, state p, state q, std::vector<std::string>* word) {
+    return findDistinguishingWord(dfa, p, dfa, q, word);
+}
+
+/**
+ * @brief Writes a word as the concatenation of its symbols
+ * 
+ * @param word The symbols of the word
+ * @return The word, or "ε" if it is empty
+ */
+std::string wordToString(std::vector<std::string> word) {
+    if (word.size() == 0) {
+        return "ε";
+    }
+    std::string text = "";
+    for (std::string symbol : word) {
+        text += symbol;
+    }
+    return text;
+}
\ No newline at end of file
@@ -0,0 +1,650 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <unordered_map>
+#include <stdexcept>
+#include "partition.cpp"
+
+// A class of affected states whose equivalence with the untouched states is not known yet
+#define CLASS_UNKNOWN -2
+// A class of affected states that is equivalent to no untouched state
+#define CLASS_UNMATCHED -3
+
+/**
+ * @brief A minimal DFA that stays minimal while transitions are added or removed and states change finality. An edit on a state only changes the languages of the states that reach it, the affected states: the others keep pairwise different languages, so the new minimal DFA only merges affected states with each other, with untouched states or with the dead state. The affected states are refined with Hopcroft's algorithm, the untouched states they reach taking part as fixed states, and each resulting class is then matched against the untouched states that share one of its transitions. States that become unreachable are removed. Only when a group of affected classes has no transition into an untouched state does the DFA fall back to a full minimization.
+ */
+class IncrementalMinimalDFA {
+private:
+    std::vector<std::string> symbols;
+    std::vector<state> names;
+    std::unordered_map<state, int> ids;
+    std::vector<int> next;
+    std::vector<bool> final_states;
+    std::vector<std::string> labels;
+    std::vector<bool> alive;
+    std::vector<std::vector<size_t>> predecessors;
+    std::vector<int> out_degree;
+    std::set<int> leaves;
+    std::vector<int> local;
+    int initial_state;
+    int state_count;
+    size_t affected_count;
+    int fallback_count;
+
+    /**
+     * @brief Changes a transition, keeping the lists of predecessors and the counts of transitions up to date
+     * 
+     * @param from The index of the state from which the transition starts
+     * @param a The index of the symbol
+     * @param to The index of the new target, or NO_STATE
+     */
+    void link(int from, int a, int to) {
+        size_t edge = (size_t) from * this->symbols.size() + a;
+        int old = this->next[edge];
+        if (old == to) {
+            return;
+        }
+        if (old != NO_STATE) {
+            std::vector<size_t>& list = this->predecessors[old];
+            for (size_t i = 0; i < list.size(); i++) {
+                if (list[i] == edge) {
+                    list[i] = list.back();
+                    list.pop_back();
+                    break;
+                }
+            }
+            if (--this->out_degree[from] == 0) {
+                this->leaves.insert(from);
+            }
+        }
+        if (to != NO_STATE) {
+            this->predecessors[to].push_back(edge);
+            if (this->out_degree[from]++ == 0) {
+                this->leaves.erase(from);
+            }
+        }
+        this->next[edge] = to;
+    }
+
+    /**
+     * @brief Makes every transition into a state go to another one, then removes the state
+     * 
+     * @param s The index of the state to be removed
+     * @param target The index of the state that replaces it, or NO_STATE to drop the transitions
+     */
+    void replaceState(int s, int target) {
+        int k = (int) this->symbols.size();
+        std::vector<size_t> incoming = this->predecessors[s];
+        for (size_t edge : incoming) {
+            this->link((int) (edge / k), (int) (edge % k), target);
+        }
+        for (int a = 0; a < k; a++) {
+            this->link(s, a, NO_STATE);
+        }
+        if (this->initial_state == s) {
+            this->initial_state = target;
+        }
+        this->alive[s] = false;
+        this->leaves.erase(s);
+        this->state_count--;
+    }
+
+    /**
+     * @brief Removes a state that may have become unreachable, together with every state only reachable through it. The states that reach it are searched backwards, and when the initial state is not among them they are all unreachable
+     * 
+     * @param s The index of the state
+     */
+    void collectGarbage(int s) {
+        std::vector<int> pending(1, s);
+        std::vector<int> ancestors;
+        while (pending.size() > 0) {
+            int t = pending.back();
+            pending.pop_back();
+            if (!this->alive[t] || this->initial_state == t) {
+                continue;
+            }
+            ancestors = this->collectAncestors(t);
+            bool reachable = false;
+            for (int u : ancestors) {
+                reachable = reachable || u == this->initial_state;
+            }
+            if (reachable) {
+                continue;
+            }
+            for (int u : ancestors) {
+                this->local[u] = 0;
+            }
+            for (int u : ancestors) {
+                for (int a = 0; a < (int) this->symbols.size(); a++) {
+                    int v = this->next[(size_t) u * this->symbols.size() + a];
+                    if (v != NO_STATE && this->local[v] == NO_STATE) {
+                        pending.push_back(v);
+                    }
+                }
+            }
+            for (int u : ancestors) {
+                this->local[u] = NO_STATE;
+                this->replaceState(u, NO_STATE);
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the states that reach a state, the state itself included
+     * 
+     * @param s The index of the state
+     * @return The indexes of the states
+     */
+    std::vector<int> collectAncestors(int s) {
+        int k = (int) this->symbols.size();
+        std::vector<int> ancestors(1, s);
+        this->local[s] = 0;
+        for (size_t i = 0; i < ancestors.size(); i++) {
+            for (size_t edge : this->predecessors[ancestors[i]]) {
+                int p = (int) (edge / k);
+                if (this->local[p] == NO_STATE) {
+                    this->local[p] = 0;
+                    ancestors.push_back(p);
+                }
+            }
+        }
+        for (int p : ancestors) {
+            this->local[p] = NO_STATE;
+        }
+        return ancestors;
+    }
+
+    /**
+     * @brief Gets the target of a transition of a class of affected states as an untouched state, when it is one
+     * 
+     * @param target The target in the refined automaton: a class, or an untouched state encoded as -3 - state
+     * @param matches The untouched state matched to each class
+     * @return The untouched state, NO_STATE for the dead state, CLASS_UNKNOWN or CLASS_UNMATCHED otherwise
+     */
+    static int resolveTarget(int target, const std::vector<int>& matches) {
+        if (target == NO_STATE || target <= -3) {
+            return target == NO_STATE ? NO_STATE : -3 - target;
+        }
+        return matches[target];
+    }
+
+    /**
+     * @brief Checks if a class of affected states has the language of an untouched state by walking both automata from the pair in lockstep. Every class met is paired with one untouched state, and the walk fails when a class would need two of them or the pair differs in finality, in label or in a transition
+     * 
+     * @param c The class
+     * @param u The untouched state
+     * @param rows The transitions of every class, as given to resolveTarget
+     * @param finals The finality of every class
+     * @param class_labels The label of every class
+     * @param matches The untouched state matched to each class. Receives the pairs of the walk when it succeeds
+     * @return true if the languages are equal. false otherwise
+     */
+    bool matchClass(int c, int u, const std::vector<int>& rows, const std::vector<bool>& finals, const std::vector<std::string>& class_labels, std::vector<int>& matches) {
+        int k = (int) this->symbols.size();
+        std::vector<std::pair<int, int>> pairs(1, std::make_pair(c, u));
+        std::unordered_map<int, int> paired;
+        paired[c] = u;
+        for (size_t i = 0; i < pairs.size(); i++) {
+            int d = pairs[i].first;
+            int v = pairs[i].second;
+            if (finals[d] != this->final_states[v] || class_labels[d] != this->labels[v]) {
+                return false;
+            }
+            for (int a = 0; a < k; a++) {
+                int target = rows[(size_t) d * k + a];
+                int expected = resolveTarget(target, matches);
+                int actual = this->next[(size_t) v * k + a];
+                if (expected == CLASS_UNMATCHED) {
+                    return false;
+                }
+                if (expected != CLASS_UNKNOWN) {
+                    if (expected != actual) {
+                        return false;
+                    }
+                    continue;
+                }
+                if (actual == NO_STATE) {
+                    return false;
+                }
+                auto it = paired.find(target);
+                if (it == paired.end()) {
+                    paired[target] = actual;
+                    pairs.push_back(std::make_pair(target, actual));
+                } else if (it->second != actual) {
+                    return false;
+                }
+            }
+        }
+        for (std::pair<int, int> pair : pairs) {
+            matches[pair.first] = pair.second;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Merges equivalent affected states. The affected states, split by finality and label, and the untouched states they reach are refined with Hopcroft's algorithm, the untouched ones each in a block of its own, and the resulting classes are matched against untouched states. A class with a transition into an untouched state v can only be equivalent to a predecessor of v with the same symbol, and a class whose transitions are all missing to the final leaf
+     * 
+     * @param affected The affected states, which are replaced by the states left afterwards
+     * @param fallback Receives whether a class could not be matched because no transition leads from it to an untouched state
+     * @return true if some class was merged into an untouched state, which may allow more merges. false otherwise
+     */
+    bool refineAffected(std::vector<int>& affected, bool* fallback) {
+        int k = (int) this->symbols.size();
+        int m = (int) affected.size();
+        for (int i = 0; i < m; i++) {
+            this->local[affected[i]] = i;
+        }
+
+        // The affected states, then one fixed state per untouched state they reach
+        IndexedDFA sub = IndexedDFA(this->symbols);
+        std::vector<int> untouched;
+        for (int i = 0; i < m; i++) {
+            sub.addState(this->names[affected[i]], this->final_states[affected[i]]);
+            sub.setStateLabel(i, this->labels[affected[i]]);
+        }
+        std::unordered_map<int, int> fixed;
+        for (int i = 0; i < m; i++) {
+            for (int a = 0; a < k; a++) {
+                int t = this->next[(size_t) affected[i] * k + a];
+                if (t == NO_STATE) {
+                    continue;
+                }
+                if (this->local[t] != NO_STATE) {
+                    sub.setTransition(i, a, this->local[t]);
+                    continue;
+                }
+                auto it = fixed.find(t);
+                if (it == fixed.end()) {
+                    it = fixed.insert(std::make_pair(t, sub.addState(this->names[t], this->final_states[t]))).first;
+                    untouched.push_back(t);
+                }
+                sub.setTransition(i, a, it->second);
+            }
+        }
+        std::vector<int> blocks = getAcceptanceLabels(sub);
+        int block_count = 2;
+        for (int i = 0; i < m; i++) {
+            block_count = std::max(block_count, blocks[i] + 1);
+        }
+        for (int i = m; i < sub.getStateCount(); i++) {
+            blocks[i] = block_count + i - m;
+        }
+        std::vector<int> classes = computeEquivalenceClasses(sub, blocks, 0);
+        int dead = classes.back();
+
+        // The transitions of every class, from its first member, with untouched targets encoded as -3 - state
+        int class_count = (int) classes.size();
+        std::vector<int> first_member(class_count, NO_STATE);
+        for (int i = 0; i < m; i++) {
+            if (first_member[classes[i]] == NO_STATE) {
+                first_member[classes[i]] = i;
+            }
+        }
+        std::vector<int> rows((size_t) class_count * k, NO_STATE);
+        std::vector<bool> finals(class_count, false);
+        std::vector<std::string> class_labels(class_count);
+        std::vector<int> matches(class_count, CLASS_UNKNOWN);
+        for (int c = 0; c < class_count; c++) {
+            int i = first_member[c];
+            if (i == NO_STATE || c == dead) {
+                continue;
+            }
+            finals[c] = this->final_states[affected[i]];
+            class_labels[c] = this->labels[affected[i]];
+            for (int a = 0; a < k; a++) {
+                int t = sub.transite(i, a);
+                if (t == NO_STATE || classes[t] == dead) {
+                    rows[(size_t) c * k + a] = NO_STATE;
+                } else if (t >= m) {
+                    rows[(size_t) c * k + a] = -3 - untouched[t - m];
+                } else {
+                    rows[(size_t) c * k + a] = classes[t];
+                }
+            }
+        }
+        for (int i = 0; i < m; i++) {
+            this->local[affected[i]] = NO_STATE;
+        }
+        for (int i = 0; i < m; i++) {
+            this->local[affected[i]] = classes[i];
+        }
+
+        // Matching the classes against untouched states until nothing changes
+        bool progress = true;
+        while (progress) {
+            progress = false;
+            for (int c = 0; c < class_count; c++) {
+                if (first_member[c] == NO_STATE || c == dead || matches[c] != CLASS_UNKNOWN) {
+                    continue;
+                }
+                int anchor = NO_STATE;
+                int anchor_symbol = 0;
+                bool unmatched = false;
+                bool complete = true;
+                bool empty = true;
+                for (int a = 0; a < k; a++) {
+                    int target = rows[(size_t) c * k + a];
+                    int resolved = resolveTarget(target, matches);
+                    empty = empty && target == NO_STATE;
+                    unmatched = unmatched || resolved == CLASS_UNMATCHED;
+                    complete = complete && resolved != CLASS_UNKNOWN;
+                    if (resolved >= 0 && (anchor == NO_STATE || this->predecessors[resolved].size() < this->predecessors[anchor].size())) {
+                        anchor = resolved;
+                        anchor_symbol = a;
+                    }
+                }
+                std::vector<int> candidates;
+                if (unmatched) {
+                    matches[c] = CLASS_UNMATCHED;
+                    progress = true;
+                    continue;
+                } else if (empty) {
+                    for (int leaf : this->leaves) {
+                        if (this->local[leaf] == NO_STATE) {
+                            candidates.push_back(leaf);
+                        }
+                    }
+                } else if (anchor != NO_STATE) {
+                    for (size_t edge : this->predecessors[anchor]) {
+                        int u = (int) (edge / k);
+                        if ((int) (edge % k) == anchor_symbol && this->local[u] == NO_STATE) {
+                            candidates.push_back(u);
+                        }
+                    }
+                } else {
+                    continue;
+                }
+                progress = true;
+                matches[c] = CLASS_UNMATCHED;
+                for (int u : candidates) {
+                    if (complete) {
+                        bool equal = this->final_states[u] == finals[c] && this->labels[u] == class_labels[c];
+                        for (int a = 0; a < k && equal; a++) {
+                            equal = this->next[(size_t) u * k + a] == resolveTarget(rows[(size_t) c * k + a], matches);
+                        }
+                        if (equal) {
+                            matches[c] = u;
+                            break;
+                        }
+                    } else {
+                        matches[c] = CLASS_UNKNOWN;
+                        if (this->matchClass(c, u, rows, finals, class_labels, matches)) {
+                            break;
+                        }
+                        matches[c] = CLASS_UNMATCHED;
+                    }
+                }
+            }
+        }
+        *fallback = false;
+        for (int c = 0; c < class_count; c++) {
+            if (first_member[c] != NO_STATE && c != dead && matches[c] == CLASS_UNKNOWN && this->state_count > m) {
+                *fallback = true;
+            }
+        }
+        for (int i = 0; i < m; i++) {
+            this->local[affected[i]] = NO_STATE;
+        }
+
+        // An empty language: only the initial state is left, without transitions
+        int initial_index = (int) (std::find(affected.begin(), affected.end(), this->initial_state) - affected.begin());
+        if (initial_index < m && classes[initial_index] == dead) {
+            int initial = this->initial_state;
+            for (int t = 0; t < (int) this->alive.size(); t++) {
+                if (this->alive[t] && t != initial) {
+                    this->replaceState(t, NO_STATE);
+                }
+            }
+            for (int a = 0; a < k; a++) {
+                this->link(initial, a, NO_STATE);
+            }
+            this->initial_state = initial;
+            this->final_states[initial] = false;
+            this->labels[initial] = "";
+            affected.assign(1, initial);
+            *fallback = false;
+            return false;
+        }
+
+        // Merging every class into its untouched match or into its first member, and dropping the dead class
+        bool merged = false;
+        std::vector<int> remaining;
+        for (int i = 0; i < m; i++) {
+            int c = classes[i];
+            int target;
+            if (c == dead) {
+                target = NO_STATE;
+            } else if (matches[c] >= 0) {
+                target = matches[c];
+                merged = true;
+            } else if (first_member[c] == i) {
+                remaining.push_back(affected[i]);
+                continue;
+            } else {
+                target = affected[first_member[c]];
+            }
+            this->replaceState(affected[i], target);
+        }
+        affected = remaining;
+        return merged;
+    }
+
+    /**
+     * @brief Makes the DFA minimal again after an edit on a state
+     * 
+     * @param s The index of the edited state
+     */
+    void restore(int s) {
+        std::vector<int> affected = this->collectAncestors(s);
+        this->affected_count = affected.size();
+        bool fallback = false;
+        while (this->refineAffected(affected, &fallback) || fallback) {
+            if (fallback) {
+                this->fallback_count++;
+                affected.clear();
+                for (int t = 0; t < (int) this->alive.size(); t++) {
+                    if (this->alive[t]) {
+                        affected.push_back(t);
+                    }
+                }
+                this->affected_count = affected.size();
+            }
+        }
+    }
+
+    /**
+     * @brief Checks that an index is a state of the DFA
+     * 
+     * @param s The index of the state
+     */
+    void checkState(int s) const {
+        if (s < 0 || s >= (int) this->alive.size() || !this->alive[s]) {
+            throw std::invalid_argument("The state " + std::to_string(s) + " does not exist.");
+        }
+    }
+
+public:
+    // Constructors
+    /**
+     * @brief Minimizes a DFA and prepares it for edits. States with different labels are never merged, and every state keeps its label through the edits
+     * 
+     * @param dfa The DFA, with only reachable states
+     */
+    IncrementalMinimalDFA(const IndexedDFA& dfa) {
+        IndexedDFA minimal = buildIndexedQuotient(dfa, computeEquivalenceClasses(dfa, getAcceptanceLabels(dfa), 0));
+        int n = minimal.getStateCount();
+        int k = minimal.getSymbolCount();
+        this->symbols = minimal.getSymbols();
+        this->next = std::vector<int>((size_t) n * k, NO_STATE);
+        this->alive = std::vector<bool>(n, true);
+        this->predecessors = std::vector<std::vector<size_t>>(n);
+        this->out_degree = std::vector<int>(n, 0);
+        this->local = std::vector<int>(n, NO_STATE);
+        for (int s = 0; s < n; s++) {
+            this->names.push_back(minimal.getStateName(s));
+            this->ids[minimal.getStateName(s)] = s;
+            this->final_states.push_back(minimal.isFinalState(s));
+            this->labels.push_back(minimal.getStateLabel(s));
+            this->leaves.insert(s);
+        }
+        for (int s = 0; s < n; s++) {
+            for (int a = 0; a < k; a++) {
+                if (minimal.transite(s, a) != NO_STATE) {
+                    this->link(s, a, minimal.transite(s, a));
+                }
+            }
+        }
+        this->initial_state = minimal.getInitialState();
+        this->state_count = n;
+        this->affected_count = 0;
+        this->fallback_count = 0;
+    }
+
+    // IncrementalMinimalDFA Operations
+    /**
+     * @brief Sets a transition, adding, changing or removing it, and makes the DFA minimal again
+     * 
+     * @param from The index of the state from which the transition starts
+     * @param symbol The index of the symbol
+     * @param to The index of the state to which the transition goes, or NO_STATE to remove it
+     */
+    void setTransition(int from, int symbol, int to) {
+        this->checkState(from);
+        if (to != NO_STATE) {
+            this->checkState(to);
+        }
+        if (symbol < 0 || symbol >= (int) this->symbols.size()) {
+            throw std::invalid_argument("The symbol " + std::to_string(symbol) + " does not exist.");
+        }
+        int old = this->next[(size_t) from * this->symbols.size() + symbol];
+        if (old == to) {
+            this->affected_count = 0;
+            return;
+        }
+        this->link(from, symbol, to);
+        if (old != NO_STATE) {
+            this->collectGarbage(old);
+        }
+        this->restore(from);
+    }
+
+    /**
+     * @brief Removes a transition and makes the DFA minimal again
+     * 
+     * @param from The index of the state from which the transition starts
+     * @param symbol The index of the symbol
+     */
+    void removeTransition(int from, int symbol) {
+        this->setTransition(from, symbol, NO_STATE);
+    }
+
+    /**
+     * @brief Sets whether a state is final and makes the DFA minimal again
+     * 
+     * @param s The index of the state
+     * @param is_final Whether the state is final
+     */
+    void setFinalState(int s, bool is_final) {
+        this->checkState(s);
+        if (this->final_states[s] == is_final) {
+            this->affected_count = 0;
+            return;
+        }
+        this->final_states[s] = is_final;
+        this->restore(s);
+    }
+
+    // IncrementalMinimalDFA Information
+    /**
+     * @brief Gets the index of a state from its name
+     * 
+     * @param name The name of the state
+     * @return The index of the state, or NO_STATE if there is no such state
+     */
+    int getStateIndex(state name) const {
+        auto it = this->ids.find(name);
+        return it == this->ids.end() || !this->alive[it->second] ? NO_STATE : it->second;
+    }
+
+    /**
+     * @brief Gets the index of a symbol
+     * 
+     * @param symbol The symbol
+     * @return The index of the symbol, or -1 if it is not in the alphabet
+     */
+    int getSymbolIndex(std::string symbol) const {
+        auto it = std::lower_bound(this->symbols.begin(), this->symbols.end(), symbol);
+        return it == this->symbols.end() || *it != symbol ? -1 : (int) (it - this->symbols.begin());
+    }
+
+    /**
+     * @brief Checks if a state is final
+     * 
+     * @param s The index of the state
+     * @return true if the state is final. false otherwise
+     */
+    bool isFinalState(int s) const {
+        return this->final_states[s];
+    }
+
+    /**
+     * @brief Gets the number of states
+     * 
+     * @return The number of states
+     */
+    int getStateCount() const {
+        return this->state_count;
+    }
+
+    /**
+     * @brief Gets the number of states the last edit had to look at
+     * 
+     * @return The number of affected states
+     */
+    size_t getLastAffectedCount() const {
+        return this->affected_count;
+    }
+
+    /**
+     * @brief Gets the number of edits that needed a full minimization
+     * 
+     * @return The number of fallbacks
+     */
+    int getFallbackCount() const {
+        return this->fallback_count;
+    }
+
+    /**
+     * @brief Convert to an IndexedDFA, numbering the states in their current order
+     * 
+     * @return The minimal DFA
+     */
+    IndexedDFA convertToIndexedDfa() const {
+        int k = (int) this->symbols.size();
+        IndexedDFA dfa = IndexedDFA(this->symbols);
+        std::vector<int> number(this->alive.size(), NO_STATE);
+        for (int s = 0; s < (int) this->alive.size(); s++) {
+            if (this->alive[s]) {
+                number[s] = dfa.addState(this->names[s], this->final_states[s]);
+                dfa.setStateLabel(number[s], this->labels[s]);
+            }
+        }
+        for (int s = 0; s < (int) this->alive.size(); s++) {
+            for (int a = 0; a < k && this->alive[s]; a++) {
+                int t = this->next[(size_t) s * k + a];
+                dfa.setTransition(number[s], a, t == NO_STATE ? NO_STATE : number[t]);
+            }
+        }
+        if (this->initial_state != NO_STATE) {
+            dfa.setInitialState(number[this->initial_state]);
+        }
+        return dfa;
+    }
+};
\ No newline at end of file
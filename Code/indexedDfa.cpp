@@ -0,0 +1,310 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <string>
+#include "dfa.cpp"
+
+#define NO_STATE -1
+
+/**
+ * @brief A DFA whose states and symbols are numbered. The transitions are kept in a flat table, one row per state and one column per symbol, where NO_STATE marks a missing transition.
+ */
+class IndexedDFA {
+private:
+    std::vector<std::string> symbols;
+    std::vector<state> names;
+    std::vector<int> transitions;
+    std::vector<bool> final_states;
+    std::vector<std::string> labels;
+    int initial_state;
+
+public:
+    // Constructors
+    IndexedDFA() {
+        this->symbols = std::vector<std::string>();
+        this->names = std::vector<state>();
+        this->transitions = std::vector<int>();
+        this->final_states = std::vector<bool>();
+        this->labels = std::vector<std::string>();
+        this->initial_state = NO_STATE;
+    }
+
+    IndexedDFA(std::vector<std::string> symbols) : IndexedDFA() {
+        this->symbols = symbols;
+    }
+
+    /**
+     * @brief Builds the canonical numbering of a DFA. Only the reachable states are kept and they are numbered in BFS order from the initial state, reading the symbols in sorted order. Two DFAs that only differ in state names get the same numbering.
+     * 
+     * @param dfa The DFA to be numbered
+     */
+    IndexedDFA(DFA dfa) : IndexedDFA() {
+        for (std::string symbol : dfa.getAlphabet()) {
+            this->symbols.push_back(symbol);
+        }
+        if (dfa.getInitialState() == "") {
+            return;
+        }
+
+        std::map<transition, state> dfa_transitions = dfa.getTransitions();
+        std::map<state, int> ids;
+        std::deque<state> queue;
+        ids[dfa.getInitialState()] = this->addState(dfa.getInitialState(), dfa.isFinalState(dfa.getInitialState()));
+        this->setStateLabel(0, dfa.getStateLabel(dfa.getInitialState()));
+        this->initial_state = 0;
+        queue.push_back(dfa.getInitialState());
+        while (queue.size() > 0) {
+            state s = queue.front();
+            queue.pop_front();
+            int from = ids[s];
+            for (int a = 0; a < this->getSymbolCount(); a++) {
+                auto it = dfa_transitions.find(std::make_pair(s, this->symbols[a]));
+                if (it == dfa_transitions.end() || it->second == DEAD_STATE) {
+                    continue;
+                }
+                auto id = ids.find(it->second);
+                if (id == ids.end()) {
+                    id = ids.insert(std::make_pair(it->second, this->addState(it->second, dfa.isFinalState(it->second)))).first;
+                    this->setStateLabel(id->second, dfa.getStateLabel(it->second));
+                    queue.push_back(it->second);
+                }
+                this->setTransition(from, a, id->second);
+            }
+        }
+    }
+
+    // IndexedDFA Creation
+    /**
+     * @brief Adds a state without transitions
+     * 
+     * @param name The name the state will have when converted back to a DFA
+     * @param is_final Whether the state is final
+     * @return The index of the new state
+     */
+    int addState(state name, bool is_final) {
+        this->names.push_back(name);
+        this->final_states.push_back(is_final);
+        this->labels.push_back("");
+        this->transitions.insert(this->transitions.end(), this->symbols.size(), NO_STATE);
+        return (int) this->names.size() - 1;
+    }
+
+    /**
+     * @brief Sets the transition of a state with a symbol
+     * 
+     * @param from The index of the state from which the transition starts
+     * @param symbol The index of the symbol that triggers the transition
+     * @param to The index of the state to which the transition goes, or NO_STATE
+     */
+    void setTransition(int from, int symbol, int to) {
+        this->transitions[(size_t) from * this->symbols.size() + symbol] = to;
+    }
+
+    /**
+     * @brief Sets the initial state
+     * 
+     * @param s The index of the state to be set as initial
+     */
+    void setInitialState(int s) {
+        this->initial_state = s;
+    }
+
+    /**
+     * @brief Sets whether a state is final
+     * 
+     * @param s The index of the state
+     * @param is_final Whether the state is final
+     */
+    void setFinalState(int s, bool is_final) {
+        this->final_states[s] = is_final;
+    }
+
+    /**
+     * @brief Sets the label of a state
+     * 
+     * @param s The index of the state
+     * @param label The label, or an empty string for none
+     */
+    void setStateLabel(int s, std::string label) {
+        this->labels[s] = label;
+    }
+
+    // IndexedDFA Information
+    /**
+     * @brief Gets the index of the state reached from a state reading a symbol
+     * 
+     * @param from The index of the state from which the transition starts
+     * @param symbol The index of the symbol that triggers the transition
+     * @return The index of the state to which the transition goes, or NO_STATE
+     */
+    int transite(int from, int symbol) const {
+        return this->transitions[(size_t) from * this->symbols.size() + symbol];
+    }
+
+    /**
+     * @brief Checks if a state is final
+     * 
+     * @param s The index of the state
+     * @return true if the state is final. false otherwise
+     */
+    bool isFinalState(int s) const {
+        return this->final_states[s];
+    }
+
+    /**
+     * @brief Gets the label of a state
+     * 
+     * @param s The index of the state
+     * @return The label of the state, or an empty string if it has none
+     */
+    const std::string& getStateLabel(int s) const {
+        return this->labels[s];
+    }
+
+    /**
+     * @brief Checks if any state has a label
+     * 
+     * @return true if some state is labelled. false otherwise
+     */
+    bool hasLabels() const {
+        for (const std::string& label : this->labels) {
+            if (label != "") {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Gets the index of the initial state
+     * 
+     * @return The index of the initial state, or NO_STATE if there is none
+     */
+    int getInitialState() const {
+        return this->initial_state;
+    }
+
+    /**
+     * @brief Gets the number of states
+     * 
+     * @return The number of states
+     */
+    int getStateCount() const {
+        return (int) this->names.size();
+    }
+
+    /**
+     * @brief Gets the number of symbols of the alphabet
+     * 
+     * @return The number of symbols
+     */
+    int getSymbolCount() const {
+        return (int) this->symbols.size();
+    }
+
+    /**
+     * @brief Gets the name of a state
+     * 
+     * @param s The index of the state
+     * @return The name of the state
+     */
+    state getStateName(int s) const {
+        return this->names[s];
+    }
+
+    /**
+     * @brief Gets a symbol of the alphabet
+     * 
+     * @param a The index of the symbol
+     * @return The symbol
+     */
+    std::string getSymbol(int a) const {
+        return this->symbols[a];
+    }
+
+    /**
+     * @brief Gets the alphabet, sorted
+     * 
+     * @return The symbols of the alphabet
+     */
+    const std::vector<std::string>& getSymbols() const {
+        return this->symbols;
+    }
+
+    /**
+     * @brief Gets the index of a symbol
+     * 
+     * @param symbol The symbol to be found
+     * @return The index of the symbol, or -1 if it is not in the alphabet
+     */
+    int getSymbolIndex(std::string symbol) const {
+        auto it = std::lower_bound(this->symbols.begin(), this->symbols.end(), symbol);
+        if (it == this->symbols.end() || *it != symbol) {
+            return -1;
+        }
+        return (int) (it - this->symbols.begin());
+    }
+
+    /**
+     * @brief Writes the automaton in a compact text form that ignores state names. Equal automata under the canonical numbering give equal strings. The labels are written at the end, only when some state has one.
+     * 
+     * @return The serialized automaton
+     */
+    std::string serialize() const {
+        std::string text = std::to_string(this->getStateCount()) + " " + std::to_string(this->getSymbolCount()) + " " + std::to_string(this->initial_state) + "\n";
+        for (std::string symbol : this->symbols) {
+            text += std::to_string(symbol.size()) + " " + symbol + "\n";
+        }
+        for (int s = 0; s < this->getStateCount(); s++) {
+            text += this->final_states[s] ? '1' : '0';
+        }
+        text += "\n";
+        for (int s = 0; s < this->getStateCount(); s++) {
+            for (int a = 0; a < this->getSymbolCount(); a++) {
+                text += std::to_string(this->transite(s, a)) + (a + 1 < this->getSymbolCount() ? " " : "");
+            }
+            text += "\n";
+        }
+        if (this->hasLabels()) {
+            for (const std::string& label : this->labels) {
+                text += std::to_string(label.size()) + " " + label + "\n";
+            }
+        }
+        return text;
+    }
+
+    /**
+     * @brief Convert the IndexedDFA to a DFA, using the state names
+     * 
+     * @return The DFA that is equivalent to the IndexedDFA
+     */
+    DFA convertToDfa() const {
+        DFA dfa = DFA();
+        for (std::string symbol : this->symbols) {
+            dfa.addSymbol(symbol);
+        }
+        for (int s = 0; s < this->getStateCount(); s++) {
+            dfa.addState(this->names[s]);
+            if (this->final_states[s]) {
+                dfa.addFinalState(this->names[s]);
+            }
+            dfa.setStateLabel(this->names[s], this->labels[s]);
+            for (int a = 0; a < this->getSymbolCount(); a++) {
+                int to = this->transite(s, a);
+                if (to != NO_STATE) {
+                    dfa.addTransition(this->names[s], this->symbols[a], this->names[to]);
+                }
+            }
+        }
+        if (this->initial_state != NO_STATE) {
+            dfa.setInitialState(this->names[this->initial_state]);
+        }
+        return dfa;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,407 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <stdexcept>
+#include "indexedDfa.cpp"
+
+// Largest Unicode code point
+#define MAX_CODE_POINT 0x10FFFF
+
+/**
+ * @brief Decodes the UTF-8 code point that starts at a position of a string
+ * 
+ * @param text The string
+ * @param position The position of the first byte, moved past the code point
+ * @param code_point Where the code point is written
+ * @return true if a valid code point was decoded. false otherwise
+ */
+inline bool decodeUtf8(const std::string& text, size_t& position, unsigned int& code_point) {
+    if (position >= text.size()) {
+        return false;
+    }
+    unsigned char lead = (unsigned char) text[position];
+    int length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+    if (length == 0 || position + length > text.size()) {
+        return false;
+    }
+    code_point = length == 1 ? lead : lead & (0x7F >> length);
+    for (int i = 1; i < length; i++) {
+        unsigned char c = (unsigned char) text[position + i];
+        if ((c >> 6) != 0x2) {
+            return false;
+        }
+        code_point = (code_point << 6) | (c & 0x3F);
+    }
+    unsigned int minimum[5] = {0, 0, 0x80, 0x800, 0x10000};
+    if (code_point < minimum[length] || code_point > MAX_CODE_POINT || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+        return false;
+    }
+    position += length;
+    return true;
+}
+
+/**
+ * @brief Encodes a code point in UTF-8
+ * 
+ * @param code_point The code point
+ * @return The bytes of the code point
+ */
+inline std::string encodeUtf8(unsigned int code_point) {
+    std::string text = "";
+    if (code_point < 0x80) {
+        text += (char) code_point;
+    } else if (code_point < 0x800) {
+        text += (char) (0xC0 | (code_point >> 6));
+        text += (char) (0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+        text += (char) (0xE0 | (code_point >> 12));
+        text += (char) (0x80 | ((code_point >> 6) & 0x3F));
+        text += (char) (0x80 | (code_point & 0x3F));
+    } else {
+        text += (char) (0xF0 | (code_point >> 18));
+        text += (char) (0x80 | ((code_point >> 12) & 0x3F));
+        text += (char) (0x80 | ((code_point >> 6) & 0x3F));
+        text += (char) (0x80 | (code_point & 0x3F));
+    }
+    return text;
+}
+
+/**
+ * @brief A transition taken by every symbol in [first, last]
+ */
+struct symbolRange {
+    unsigned int first;
+    unsigned int last;
+    int to;
+};
+
+/**
+ * @brief A DFA over code points whose transitions are labelled with ranges of symbols. Each state keeps a sorted list of disjoint ranges, and adjacent ranges going to the same state are merged, so memory grows with the number of distinct ranges instead of the size of the alphabet. Symbols outside every range go to an implicit dead state.
+ */
+class IntervalDFA {
+private:
+    std::vector<state> names;
+    std::vector<std::vector<symbolRange>> ranges;
+    std::vector<bool> final_states;
+    int initial_state;
+
+public:
+    // Constructors
+    IntervalDFA() {
+        this->names = std::vector<state>();
+        this->ranges = std::vector<std::vector<symbolRange>>();
+        this->final_states = std::vector<bool>();
+        this->initial_state = NO_STATE;
+    }
+
+    /**
+     * @brief Builds the ranges of a DFA whose symbols are single UTF-8 code points. Only the reachable states are kept, numbered in BFS order like IndexedDFA
+     * 
+     * @param dfa The DFA
+     */
+    IntervalDFA(DFA dfa) : IntervalDFA() {
+        IndexedDFA indexed = IndexedDFA(dfa);
+        std::vector<unsigned int> code_points;
+        for (std::string symbol : indexed.getSymbols()) {
+            size_t position = 0;
+            unsigned int code_point = 0;
+            if (!decodeUtf8(symbol, position, code_point) || position != symbol.size()) {
+                throw std::invalid_argument("The symbol \"" + symbol + "\" is not a single UTF-8 code point.");
+            }
+            code_points.push_back(code_point);
+        }
+        for (int s = 0; s < indexed.getStateCount(); s++) {
+            this->addState(indexed.getStateName(s), indexed.isFinalState(s));
+            for (int a = 0; a < indexed.getSymbolCount(); a++) {
+                if (indexed.transite(s, a) != NO_STATE) {
+                    this->addRange(s, code_points[a], code_points[a], indexed.transite(s, a));
+                }
+            }
+        }
+        this->initial_state = indexed.getInitialState();
+    }
+
+    // IntervalDFA Creation
+    /**
+     * @brief Adds a state without transitions
+     * 
+     * @param name The name of the state
+     * @param is_final Whether the state is final
+     * @return The index of the new state
+     */
+    int addState(state name, bool is_final) {
+        this->names.push_back(name);
+        this->final_states.push_back(is_final);
+        this->ranges.push_back(std::vector<symbolRange>());
+        return (int) this->names.size() - 1;
+    }
+
+    /**
+     * @brief Adds a transition taken by every symbol of a range, merging it with the neighbouring ranges that go to the same state
+     * 
+     * @param from The index of the state from which the transition starts
+     * @param first The first symbol of the range
+     * @param last The last symbol of the range
+     * @param to The index of the state to which the transition goes
+     */
+    void addRange(int from, unsigned int first, unsigned int last, int to) {
+        if (first > last || last > MAX_CODE_POINT) {
+            throw std::invalid_argument("Invalid symbol range.");
+        }
+        std::vector<symbolRange>& list = this->ranges[from];
+        auto it = std::lower_bound(list.begin(), list.end(), first, [](const symbolRange& r, unsigned int symbol) { return r.last < symbol; });
+        if (it != list.end() && it->first <= last) {
+            throw std::invalid_argument("The range overlaps another transition of state " + this->names[from] + ".");
+        }
+        it = list.insert(it, symbolRange{first, last, to});
+        if (it + 1 != list.end() && (it + 1)->to == to && (it + 1)->first == last + 1) {
+            it->last = (it + 1)->last;
+            list.erase(it + 1);
+        }
+        if (it != list.begin() && (it - 1)->to == to && (it - 1)->last + 1 == first) {
+            (it - 1)->last = it->last;
+            list.erase(it);
+        }
+    }
+
+    /**
+     * @brief Sets the initial state
+     * 
+     * @param s The index of the state to be set as initial
+     */
+    void setInitialState(int s) {
+        this->initial_state = s;
+    }
+
+    /**
+     * @brief Sets whether a state is final
+     * 
+     * @param s The index of the state
+     * @param is_final Whether the state is final
+     */
+    void setFinalState(int s, bool is_final) {
+        this->final_states[s] = is_final;
+    }
+
+    // IntervalDFA Information
+    /**
+     * @brief Gets the state reached from a state reading a symbol, with a binary search over its ranges
+     * 
+     * @param from The index of the state from which the transition starts
+     * @param symbol The code point read
+     * @return The index of the state to which the transition goes, or NO_STATE
+     */
+    int transite(int from, unsigned int symbol) const {
+        const std::vector<symbolRange>& list = this->ranges[from];
+        auto it = std::lower_bound(list.begin(), list.end(), symbol, [](const symbolRange& r, unsigned int c) { return r.last < c; });
+        return it != list.end() && it->first <= symbol ? it->to : NO_STATE;
+    }
+
+    /**
+     * @brief Checks if a state is final
+     * 
+     * @param s The index of the state
+     * @return true if the state is final. false otherwise
+     */
+    bool isFinalState(int s) const {
+        return this->final_states[s];
+    }
+
+    /**
+     * @brief Gets the index of the initial state
+     * 
+     * @return The index of the initial state, or NO_STATE if there is none
+     */
+    int getInitialState() const {
+        return this->initial_state;
+    }
+
+    /**
+     * @brief Gets the number of states
+     * 
+     * @return The number of states
+     */
+    int getStateCount() const {
+        return (int) this->names.size();
+    }
+
+    /**
+     * @brief Gets the total number of ranges
+     * 
+     * @return The number of ranges of all states
+     */
+    size_t getRangeCount() const {
+        size_t count = 0;
+        for (const std::vector<symbolRange>& list : this->ranges) {
+            count += list.size();
+        }
+        return count;
+    }
+
+    /**
+     * @brief Gets the name of a state
+     * 
+     * @param s The index of the state
+     * @return The name of the state
+     */
+    state getStateName(int s) const {
+        return this->names[s];
+    }
+
+    /**
+     * @brief Gets the ranges of a state
+     * 
+     * @param s The index of the state
+     * @return The ranges, sorted and disjoint
+     */
+    const std::vector<symbolRange>& getRanges(int s) const {
+        return this->ranges[s];
+    }
+
+    // IntervalDFA Operations
+    /**
+     * @brief Checks if the DFA accepts a UTF-8 word
+     * 
+     * @param word The word
+     * @return true if the word is accepted. false otherwise, also when the word is not valid UTF-8
+     */
+    bool matches(const std::string& word) const {
+        int s = this->initial_state;
+        size_t position = 0;
+        while (s != NO_STATE && position < word.size()) {
+            unsigned int code_point = 0;
+            if (!decodeUtf8(word, position, code_point)) {
+                return false;
+            }
+            s = this->transite(s, code_point);
+        }
+        return s != NO_STATE && this->final_states[s];
+    }
+
+    /**
+     * @brief Minimizes the DFA by refining over the range boundaries. Each round describes a state by its finality, its class and its ranges with the targets replaced by their classes, merging adjacent ranges that reach the same class and dropping those that reach the class of the dead state; states with equal descriptions share the next class. The refinement stops when a round creates no class, and every round costs time proportional to the number of ranges, not to the size of the alphabet
+     * 
+     * @return The minimal DFA. Its states are named after the states they merge, joined by commas, and states equivalent to the dead state are dropped
+     */
+    IntervalDFA minimize() const {
+        // Reachable states in BFS order, the dead state kept at index n
+        std::vector<int> order;
+        std::vector<int> id(this->getStateCount(), NO_STATE);
+        if (this->initial_state != NO_STATE) {
+            order.push_back(this->initial_state);
+            id[this->initial_state] = 0;
+        }
+        for (size_t head = 0; head < order.size(); head++) {
+            for (const symbolRange& r : this->ranges[order[head]]) {
+                if (id[r.to] == NO_STATE) {
+                    id[r.to] = (int) order.size();
+                    order.push_back(r.to);
+                }
+            }
+        }
+        int n = (int) order.size();
+
+        std::vector<int> classes(n + 1);
+        for (int s = 0; s <= n; s++) {
+            classes[s] = s < n && this->final_states[order[s]] ? 1 : 0;
+        }
+        int class_count = 0;
+        std::vector<std::vector<unsigned int>> descriptions(n + 1);
+        for (bool changed = true; changed;) {
+            for (int s = 0; s <= n; s++) {
+                std::vector<unsigned int>& description = descriptions[s];
+                description.assign(1, (unsigned int) classes[s]);
+                if (s == n) {
+                    continue;
+                }
+                for (const symbolRange& r : this->ranges[order[s]]) {
+                    unsigned int target = (unsigned int) classes[id[r.to]];
+                    if ((int) target == classes[n]) {
+                        continue;
+                    }
+                    size_t size = description.size();
+                    if (size > 1 && description[size - 1] == target && description[size - 2] + 1 == r.first) {
+                        description[size - 2] = r.last;
+                        continue;
+                    }
+                    description.push_back(r.first);
+                    description.push_back(r.last);
+                    description.push_back(target);
+                }
+            }
+            std::map<std::vector<unsigned int>, int> refined;
+            std::vector<int> next(n + 1);
+            for (int s = 0; s <= n; s++) {
+                next[s] = refined.insert(std::make_pair(descriptions[s], (int) refined.size())).first->second;
+            }
+            changed = (int) refined.size() != class_count;
+            class_count = (int) refined.size();
+            classes = next;
+        }
+
+        // Building the quotient from the last descriptions, one state per class other than the dead one
+        IntervalDFA minimal = IntervalDFA();
+        std::vector<int> number(class_count, NO_STATE);
+        std::vector<std::string> members(class_count, "");
+        for (int s = 0; s < n; s++) {
+            members[classes[s]] += (members[classes[s]].size() > 0 ? "," : "") + this->names[order[s]];
+        }
+        for (int s = 0; s < n; s++) {
+            if (classes[s] != classes[n] && number[classes[s]] == NO_STATE) {
+                number[classes[s]] = minimal.addState(members[classes[s]], this->final_states[order[s]]);
+            }
+        }
+        std::vector<bool> built(class_count, false);
+        for (int s = 0; s < n; s++) {
+            int c = classes[s];
+            if (number[c] == NO_STATE || built[c]) {
+                continue;
+            }
+            built[c] = true;
+            const std::vector<unsigned int>& description = descriptions[s];
+            for (size_t i = 1; i < description.size(); i += 3) {
+                minimal.ranges[number[c]].push_back(symbolRange{description[i], description[i + 1], number[description[i + 2]]});
+            }
+        }
+        if (n > 0 && number[classes[0]] != NO_STATE) {
+            minimal.initial_state = number[classes[0]];
+        } else if (n > 0) {
+            minimal.initial_state = minimal.addState(members[classes[0]], false);
+        }
+        return minimal;
+    }
+
+    /**
+     * @brief Convert the IntervalDFA to a DFA with one symbol per code point. The DFA stores one transition per symbol of every range, so this is only meant for small alphabets
+     * 
+     * @return The DFA that is equivalent to the IntervalDFA
+     */
+    DFA convertToDfa() const {
+        DFA dfa = DFA();
+        for (int s = 0; s < this->getStateCount(); s++) {
+            dfa.addState(this->names[s]);
+            if (this->final_states[s]) {
+                dfa.addFinalState(this->names[s]);
+            }
+            for (const symbolRange& r : this->ranges[s]) {
+                for (unsigned int c = r.first; c <= r.last; c++) {
+                    if (c >= 0xD800 && c <= 0xDFFF) {
+                        continue;
+                    }
+                    dfa.addSymbol(encodeUtf8(c));
+                    dfa.addTransition(this->names[s], encodeUtf8(c), this->names[r.to]);
+                }
+            }
+        }
+        if (this->initial_state != NO_STATE) {
+            dfa.setInitialState(this->names[this->initial_state]);
+        }
+        return dfa;
+    }
+};
\ No newline at end of file
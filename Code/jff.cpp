@@ -0,0 +1,421 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <cstdio>
+#include "pugixml/pugixml.hpp"
+#include "dfa.cpp"
+#include "intervalDfa.cpp"
+#include "nfa.cpp"
+#include "dawg.cpp"
+#include "transducer.cpp"
+
+/**
+ * @brief Reads a state id of a JFLAP file. The empty id is refused, since it is the name of the virtual dead state
+ * 
+ * @param id The id, from a state node or from the from or to of a transition
+ * @return The id
+ */
+std::string checkStateId(std::string id) {
+    if (id == DEAD_STATE) {
+        throw std::invalid_argument("A state has an empty id, which is reserved for the dead state.");
+    }
+    return id;
+}
+
+/**
+ * @brief Sets up a DFA from the automaton node of a JFLAP file. The label element JFLAP saves for a state becomes its label
+ * 
+ * @param automaton The automaton node
+ * @return The DFA described by the node
+ */
+DFA parseJffAutomaton(pugi::xml_node automaton) {
+    DFA dfa = DFA();
+
+    // Setting up states
+    for (pugi::xml_node node = automaton.child("state"); node; node = node.next_sibling("state")) {
+        std::string id = checkStateId(node.attribute("id").value());
+        dfa.addState(id);
+        if (node.child("initial")) {
+            dfa.setInitialState(id);
+        }
+        if (node.child("final")) {
+            dfa.addFinalState(id);
+        }
+        dfa.setStateLabel(id, node.child_value("label"));
+    }
+
+    // Setting up transitions
+    for (pugi::xml_node node = automaton.child("transition"); node; node = node.next_sibling("transition")) {
+        std::string symbol = node.child_value("read");
+        dfa.addSymbol(symbol);
+        dfa.addTransition(checkStateId(node.child_value("from")), symbol, checkStateId(node.child_value("to")));
+    }
+
+    return dfa;
+}
+
+/**
+ * @brief Sets up an NFA from the automaton node of a JFLAP file. An empty read is an ε-transition, repeated (from, read) pairs keep all their targets and several states may be initial. Labels are numbered in the order they first appear in the file, which is their priority
+ * 
+ * @param automaton The automaton node
+ * @return The NFA described by the node
+ */
+NFA parseJffNfa(pugi::xml_node automaton) {
+    // Setting up alphabet
+    std::vector<std::string> symbols;
+    for (pugi::xml_node node = automaton.child("transition"); node; node = node.next_sibling("transition")) {
+        std::string symbol = node.child_value("read");
+        if (symbol != "") {
+            symbols.push_back(symbol);
+        }
+    }
+    std::sort(symbols.begin(), symbols.end());
+    symbols.erase(std::unique(symbols.begin(), symbols.end()), symbols.end());
+    NFA nfa = NFA(symbols);
+
+    // Setting up states
+    std::map<state, int> ids;
+    for (pugi::xml_node node = automaton.child("state"); node; node = node.next_sibling("state")) {
+        std::string id = checkStateId(node.attribute("id").value());
+        ids[id] = nfa.addState(id, (bool) node.child("final"));
+        nfa.setStateLabel(ids[id], nfa.addLabel(node.child_value("label")));
+        if (node.child("initial")) {
+            nfa.addInitialState(ids[id]);
+        }
+    }
+
+    // Setting up transitions
+    for (pugi::xml_node node = automaton.child("transition"); node; node = node.next_sibling("transition")) {
+        auto from = ids.find(node.child_value("from"));
+        auto to = ids.find(node.child_value("to"));
+        if (from == ids.end() || to == ids.end()) {
+            throw std::invalid_argument("A transition uses an unknown state.");
+        }
+        std::string symbol = node.child_value("read");
+        int a = symbol == "" ? EPSILON : (int) (std::lower_bound(symbols.begin(), symbols.end(), symbol) - symbols.begin());
+        nfa.addTransition(from->second, a, to->second);
+    }
+
+    return nfa;
+}
+
+/**
+ * @brief Writes the states, their labels and the transitions of a DFA in the automaton node of a JFLAP file
+ * 
+ * @param dfa The DFA to be written
+ * @param automaton The automaton node
+ */
+void appendDfaToJff(DFA dfa, pugi::xml_node automaton) {
+    // Setting up states
+    for (state s : dfa.getStates()) {
+        if (s == DEAD_STATE) {
+            continue;
+        }
+        pugi::xml_node state = automaton.append_child("state");
+        state.append_attribute("id") = s.c_str();
+        state.append_attribute("name") = ("q" + s).c_str();
+        state.append_child("x").append_child(pugi::node_pcdata).set_value("0");
+        state.append_child("y").append_child(pugi::node_pcdata).set_value("0");
+        if (s == dfa.getInitialState()) {
+            state.append_child("initial");
+        }
+        if (dfa.isFinalState(s)) {
+            state.append_child("final");
+        }
+        if (dfa.getStateLabel(s) != "") {
+            state.append_child("label").append_child(pugi::node_pcdata).set_value(dfa.getStateLabel(s).c_str());
+        }
+    }
+
+    // Setting up transitions
+    for (std::pair<const transition, state> const& it : dfa.getTransitions()) {
+        if (it.second == DEAD_STATE) {
+            continue;
+        }
+        pugi::xml_node transition = automaton.append_child("transition");
+        const pugi::char_t* state1 = it.first.first.c_str();
+        const pugi::char_t* state2 = it.second.c_str();
+        const pugi::char_t* symbol = it.first.second.c_str();
+        transition.append_child("from").append_child(pugi::node_pcdata).set_value(state1);
+        transition.append_child("to").append_child(pugi::node_pcdata).set_value(state2);
+        transition.append_child("read").append_child(pugi::node_pcdata).set_value(symbol);
+    }
+}
+
+/**
+ * @brief Reads a DFA from a JFLAP file, without any interaction
+ * 
+ * @param file_path The path of the file
+ * @param dfa Where the DFA is written
+ * @return true if the file was read. false if it does not exist or is not valid XML
+ */
+bool readDfaFromJff(std::string file_path, DFA* dfa) {
+    if (!existsFile(file_path)) {
+        return false;
+    }
+    pugi::xml_document file;
+    if (!file.load_file(file_path.c_str())) {
+        return false;
+    }
+    *dfa = parseJffAutomaton(file.child("structure").child("automaton"));
+    return true;
+}
+
+/**
+ * @brief Reads an NFA from a JFLAP file, without any interaction
+ * 
+ * @param file_path The path of the file
+ * @param nfa Where the NFA is written
+ * @return true if the file was read. false if it does not exist or is not valid XML
+ */
+bool readNfaFromJff(std::string file_path, NFA* nfa) {
+    if (!existsFile(file_path)) {
+        return false;
+    }
+    pugi::xml_document file;
+    if (!file.load_file(file_path.c_str())) {
+        return false;
+    }
+    *nfa = parseJffNfa(file.child("structure").child("automaton"));
+    return true;
+}
+
+/**
+ * @brief Reads a bound of a range label, written either as a single UTF-8 character or as U+ followed by the hexadecimal code point
+ * 
+ * @param text The bound
+ * @param code_point Where the code point is written
+ * @return true if the bound is valid. false otherwise
+ */
+bool parseRangeBound(std::string text, unsigned int* code_point) {
+    if (text.size() > 2 && text[0] == 'U' && text[1] == '+') {
+        if (text.size() > 8 || text.find_first_not_of("0123456789abcdefABCDEF", 2) != std::string::npos) {
+            return false;
+        }
+        *code_point = (unsigned int) std::stoul(text.substr(2), nullptr, 16);
+        return *code_point <= MAX_CODE_POINT;
+    }
+    size_t position = 0;
+    return decodeUtf8(text, position, *code_point) && position == text.size();
+}
+
+/**
+ * @brief Writes a bound of a range label, as a character when it is printable ASCII and as U+ followed by the hexadecimal code point otherwise
+ * 
+ * @param code_point The code point
+ * @return The bound
+ */
+std::string formatRangeBound(unsigned int code_point) {
+    if (code_point > 0x20 && code_point < 0x7F && code_point != '-') {
+        return encodeUtf8(code_point);
+    }
+    char text[16];
+    std::snprintf(text, sizeof(text), "U+%04X", code_point);
+    return text;
+}
+
+/**
+ * @brief Sets up an IntervalDFA from the automaton node of a JFLAP file. Each read is a single symbol or a range "first-last", and the bounds may be written as U+ followed by the hexadecimal code point
+ * 
+ * @param automaton The automaton node
+ * @return The IntervalDFA described by the node
+ */
+IntervalDFA parseJffIntervalAutomaton(pugi::xml_node automaton) {
+    IntervalDFA dfa = IntervalDFA();
+    std::map<state, int> ids;
+
+    // Setting up states
+    for (pugi::xml_node node = automaton.child("state"); node; node = node.next_sibling("state")) {
+        std::string id = checkStateId(node.attribute("id").value());
+        ids[id] = dfa.addState(id, (bool) node.child("final"));
+        if (node.child("initial")) {
+            dfa.setInitialState(ids[id]);
+        }
+    }
+
+    // Setting up transitions
+    for (pugi::xml_node node = automaton.child("transition"); node; node = node.next_sibling("transition")) {
+        std::string label = node.child_value("read");
+        auto from = ids.find(node.child_value("from"));
+        auto to = ids.find(node.child_value("to"));
+        if (from == ids.end() || to == ids.end()) {
+            throw std::invalid_argument("A transition uses an unknown state.");
+        }
+        unsigned int first = 0, last = 0;
+        bool valid = parseRangeBound(label, &first);
+        last = first;
+        for (size_t dash = label.find('-', 1); !valid && dash != std::string::npos; dash = label.find('-', dash + 1)) {
+            valid = parseRangeBound(label.substr(0, dash), &first) && parseRangeBound(label.substr(dash + 1), &last);
+        }
+        if (!valid) {
+            throw std::invalid_argument("The label \"" + label + "\" is neither a symbol nor a range.");
+        }
+        dfa.addRange(from->second, first, last, to->second);
+    }
+
+    return dfa;
+}
+
+/**
+ * @brief Writes the states and range-labelled transitions of an IntervalDFA in the automaton node of a JFLAP file
+ * 
+ * @param dfa The IntervalDFA to be written
+ * @param automaton The automaton node
+ */
+void appendIntervalDfaToJff(const IntervalDFA& dfa, pugi::xml_node automaton) {
+    // Setting up states
+    for (int s = 0; s < dfa.getStateCount(); s++) {
+        pugi::xml_node state = automaton.append_child("state");
+        state.append_attribute("id") = std::to_string(s).c_str();
+        state.append_attribute("name") = dfa.getStateName(s).c_str();
+        state.append_child("x").append_child(pugi::node_pcdata).set_value("0");
+        state.append_child("y").append_child(pugi::node_pcdata).set_value("0");
+        if (s == dfa.getInitialState()) {
+            state.append_child("initial");
+        }
+        if (dfa.isFinalState(s)) {
+            state.append_child("final");
+        }
+    }
+
+    // Setting up transitions
+    for (int s = 0; s < dfa.getStateCount(); s++) {
+        for (const symbolRange& r : dfa.getRanges(s)) {
+            std::string label = formatRangeBound(r.first);
+            if (r.last != r.first) {
+                label += "-" + formatRangeBound(r.last);
+            }
+            pugi::xml_node transition = automaton.append_child("transition");
+            transition.append_child("from").append_child(pugi::node_pcdata).set_value(std::to_string(s).c_str());
+            transition.append_child("to").append_child(pugi::node_pcdata).set_value(std::to_string(r.to).c_str());
+            transition.append_child("read").append_child(pugi::node_pcdata).set_value(label.c_str());
+        }
+    }
+}
+
+/**
+ * @brief Writes the states and transitions of a finished DawgBuilder in the automaton node of a JFLAP file, straight from its transition lists
+ * 
+ * @param dawg The finished builder
+ * @param automaton The automaton node
+ */
+void appendDawgToJff(const DawgBuilder& dawg, pugi::xml_node automaton) {
+    // Setting up states
+    for (int s = 0; s < dawg.getStateCount(); s++) {
+        pugi::xml_node state = automaton.append_child("state");
+        state.append_attribute("id") = std::to_string(s).c_str();
+        state.append_attribute("name") = ("q" + std::to_string(s)).c_str();
+        state.append_child("x").append_child(pugi::node_pcdata).set_value("0");
+        state.append_child("y").append_child(pugi::node_pcdata).set_value("0");
+        if (s == 0) {
+            state.append_child("initial");
+        }
+        if (dawg.isFinalState(s)) {
+            state.append_child("final");
+        }
+    }
+
+    // Setting up transitions
+    for (int s = 0; s < dawg.getStateCount(); s++) {
+        for (std::pair<unsigned char, int> edge : dawg.getEdges(s)) {
+            pugi::xml_node transition = automaton.append_child("transition");
+            transition.append_child("from").append_child(pugi::node_pcdata).set_value(std::to_string(s).c_str());
+            transition.append_child("to").append_child(pugi::node_pcdata).set_value(std::to_string(edge.second).c_str());
+            transition.append_child("read").append_child(pugi::node_pcdata).set_value(std::string(1, (char) edge.first).c_str());
+        }
+    }
+}
+
+/**
+ * @brief Sets up a Moore or Mealy machine from the structure node of a JFLAP file. The type element tells which one it is, the output element of a state is its Moore output and the transout element of a transition is its Mealy output
+ * 
+ * @param structure The structure node
+ * @return The machine described by the node, with only its reachable states
+ */
+Transducer parseJffTransducer(pugi::xml_node structure) {
+    std::string type = structure.child_value("type");
+    if (type != "moore" && type != "mealy") {
+        throw std::invalid_argument("The file holds neither a Moore nor a Mealy machine.");
+    }
+    pugi::xml_node automaton = structure.child("automaton");
+    if (!parseJffNfa(automaton).isDeterministic()) {
+        throw std::invalid_argument("The machine is not deterministic.");
+    }
+    IndexedDFA dfa = IndexedDFA(parseJffAutomaton(automaton));
+    Transducer machine = Transducer(type == "moore" ? MACHINE_MOORE : MACHINE_MEALY, dfa);
+
+    // Setting up outputs
+    std::map<state, std::string> state_outputs;
+    for (pugi::xml_node node = automaton.child("state"); node; node = node.next_sibling("state")) {
+        state_outputs[node.attribute("id").value()] = node.child_value("output");
+    }
+    std::map<transition, std::string> transition_outputs;
+    for (pugi::xml_node node = automaton.child("transition"); node; node = node.next_sibling("transition")) {
+        transition_outputs[std::make_pair(node.child_value("from"), node.child_value("read"))] = node.child_value("transout");
+    }
+    for (int s = 0; s < dfa.getStateCount(); s++) {
+        machine.setStateOutput(s, state_outputs[dfa.getStateName(s)]);
+        for (int a = 0; a < dfa.getSymbolCount(); a++) {
+            if (dfa.transite(s, a) != NO_STATE) {
+                machine.setTransitionOutput(s, a, transition_outputs[std::make_pair(dfa.getStateName(s), dfa.getSymbol(a))]);
+            }
+        }
+    }
+
+    return machine;
+}
+
+/**
+ * @brief Writes a Moore or Mealy machine in the structure node of a JFLAP file, setting its type and writing the outputs where JFLAP expects them
+ * 
+ * @param machine The machine to be written
+ * @param structure The structure node
+ */
+void appendTransducerToJff(const Transducer& machine, pugi::xml_node structure) {
+    const IndexedDFA& dfa = machine.getDfa();
+    bool moore = machine.getType() == MACHINE_MOORE;
+    structure.child("type").text().set(moore ? "moore" : "mealy");
+    pugi::xml_node automaton = structure.child("automaton");
+
+    // Setting up states
+    for (int s = 0; s < dfa.getStateCount(); s++) {
+        pugi::xml_node state = automaton.append_child("state");
+        state.append_attribute("id") = std::to_string(s).c_str();
+        state.append_attribute("name") = ("q" + std::to_string(s)).c_str();
+        state.append_child("x").append_child(pugi::node_pcdata).set_value("0");
+        state.append_child("y").append_child(pugi::node_pcdata).set_value("0");
+        if (s == dfa.getInitialState()) {
+            state.append_child("initial");
+        }
+        if (dfa.isFinalState(s)) {
+            state.append_child("final");
+        }
+        if (dfa.getStateLabel(s) != "") {
+            state.append_child("label").append_child(pugi::node_pcdata).set_value(dfa.getStateLabel(s).c_str());
+        }
+        if (moore) {
+            state.append_child("output").append_child(pugi::node_pcdata).set_value(machine.getStateOutput(s).c_str());
+        }
+    }
+
+    // Setting up transitions
+    for (int s = 0; s < dfa.getStateCount(); s++) {
+        for (int a = 0; a < dfa.getSymbolCount(); a++) {
+            int t = dfa.transite(s, a);
+            if (t == NO_STATE) {
+                continue;
+            }
+            pugi::xml_node transition = automaton.append_child("transition");
+            transition.append_child("from").append_child(pugi::node_pcdata).set_value(std::to_string(s).c_str());
+            transition.append_child("to").append_child(pugi::node_pcdata).set_value(std::to_string(t).c_str());
+            transition.append_child("read").append_child(pugi::node_pcdata).set_value(dfa.getSymbol(a).c_str());
+            if (!moore) {
+                transition.append_child("transout").append_child(pugi::node_pcdata).set_value(machine.getTransitionOutput(s, a).c_str());
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,226 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include "subset.cpp"
+
+// A transition of the lazy DFA that was not computed yet
+#define LAZY_UNKNOWN -2
+// Smallest number of states the lazy DFA cache holds, whatever its byte budget
+#define LAZY_MIN_STATES 16
+
+/**
+ * @brief A DFA built on demand from an NFA, in the style of RE2. A DFA state and its transitions are only computed the first time a match reaches them, and they are kept in a cache bounded by a byte budget. When the cache is full it is flushed and rebuilt from the states the next matches reach, so the matcher keeps working on NFAs whose full subset construction would never fit in memory. Every symbol must be a single byte. The NFA must outlive the lazy DFA.
+ */
+class LazyDFA {
+private:
+    const NFA* nfa;
+    SubsetStepper stepper;
+    SuperstateTable table;
+    std::vector<int> next;
+    std::vector<bool> accepting;
+    std::vector<unsigned long long> initial_set;
+    std::vector<unsigned long long> successor;
+    int byte_symbol[256];
+    int initial_state;
+    size_t max_states;
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long flushes;
+    unsigned long long built_states;
+
+    /**
+     * @brief Empties the cache
+     */
+    void flush() {
+        this->table.clear();
+        this->next.clear();
+        this->accepting.clear();
+        this->initial_state = LAZY_UNKNOWN;
+        this->flushes++;
+    }
+
+    /**
+     * @brief Gets the cached state of a set, adding it to the cache when it is not there. The cache is flushed first when it is full
+     * 
+     * @param set The words of the bitset. It must not point inside the cache
+     * @return The index of the state
+     */
+    int addState(const unsigned long long* set) {
+        bool inserted = false;
+        if ((size_t) this->table.size() >= this->max_states) {
+            this->flush();
+        }
+        int id = this->table.intern(set, &inserted);
+        if (inserted) {
+            this->next.insert(this->next.end(), this->nfa->getSymbolCount(), LAZY_UNKNOWN);
+            this->accepting.push_back(this->stepper.isAccepting(set));
+            this->built_states++;
+        }
+        return id;
+    }
+
+    /**
+     * @brief Computes and caches a transition that is not in the cache
+     * 
+     * @param from The index of the state
+     * @param a The index of the symbol
+     * @return The index of the next state, or NO_STATE when no NFA state is left
+     */
+    int computeTransition(int from, int a) {
+        if (!this->stepper.stepSymbol(this->table.get(from), a, this->successor.data())) {
+            this->next[(size_t) from * this->nfa->getSymbolCount() + a] = NO_STATE;
+            return NO_STATE;
+        }
+        unsigned long long flushes_before = this->flushes;
+        int to = this->addState(this->successor.data());
+        if (this->flushes == flushes_before) {
+            this->next[(size_t) from * this->nfa->getSymbolCount() + a] = to;
+        }
+        return to;
+    }
+
+public:
+    // Constructors
+    /**
+     * @brief Prepares a lazy DFA, without building any state yet
+     * 
+     * @param nfa The NFA. Every symbol must be a single byte
+     * @param cache_bytes The byte budget of the state cache
+     */
+    LazyDFA(const NFA& nfa, size_t cache_bytes) : stepper(nfa), table(nfa.getStateCount()) {
+        this->nfa = &nfa;
+        std::fill(this->byte_symbol, this->byte_symbol + 256, NO_STATE);
+        for (int a = 0; a < nfa.getSymbolCount(); a++) {
+            if (nfa.getSymbol(a).size() != 1) {
+                throw std::invalid_argument("The symbol \"" + nfa.getSymbol(a) + "\" is not a single byte.");
+            }
+            this->byte_symbol[(unsigned char) nfa.getSymbol(a)[0]] = a;
+        }
+        // Bitset, hash, two slots, one row of transitions and one accepting flag per state
+        size_t state_bytes = this->table.getWordCount() * sizeof(unsigned long long) + sizeof(unsigned long long) + 2 * sizeof(int) + nfa.getSymbolCount() * sizeof(int) + 1;
+        this->max_states = std::max((size_t) LAZY_MIN_STATES, cache_bytes / state_bytes);
+        this->initial_set = std::vector<unsigned long long>(this->table.getWordCount());
+        this->successor = std::vector<unsigned long long>(this->table.getWordCount());
+        this->stepper.getInitialSet(this->initial_set.data());
+        this->initial_state = LAZY_UNKNOWN;
+        this->hits = 0;
+        this->misses = 0;
+        this->flushes = 0;
+        this->built_states = 0;
+    }
+
+    // Matching
+    /**
+     * @brief Checks if the NFA accepts a word, building the states the word reaches
+     * 
+     * @param data The bytes of the word
+     * @param length The number of bytes
+     * @return true if the word is accepted. false otherwise
+     */
+    bool matches(const char* data, size_t length) {
+        if (this->nfa->getInitialStates().size() == 0) {
+            return false;
+        }
+        if (this->initial_state == LAZY_UNKNOWN) {
+            this->initial_state = this->addState(this->initial_set.data());
+        }
+        int s = this->initial_state;
+        int k = this->nfa->getSymbolCount();
+        for (size_t i = 0; i < length; i++) {
+            int a = this->byte_symbol[(unsigned char) data[i]];
+            if (a == NO_STATE) {
+                return false;
+            }
+            int t = this->next[(size_t) s * k + a];
+            if (t == LAZY_UNKNOWN) {
+                this->misses++;
+                t = this->computeTransition(s, a);
+            } else {
+                this->hits++;
+            }
+            if (t == NO_STATE) {
+                return false;
+            }
+            s = t;
+        }
+        return this->accepting[s];
+    }
+
+    /**
+     * @brief Checks if the NFA accepts a word, building the states the word reaches
+     * 
+     * @param word The word
+     * @return true if the word is accepted. false otherwise
+     */
+    bool matches(const std::string& word) {
+        return this->matches(word.data(), word.size());
+    }
+
+    // LazyDFA Information
+    /**
+     * @brief Gets the number of transitions that were found in the cache
+     * 
+     * @return The number of hits
+     */
+    unsigned long long getHits() {
+        return this->hits;
+    }
+
+    /**
+     * @brief Gets the number of transitions that had to be computed
+     * 
+     * @return The number of misses
+     */
+    unsigned long long getMisses() {
+        return this->misses;
+    }
+
+    /**
+     * @brief Gets the fraction of the transitions taken that were found in the cache
+     * 
+     * @return The hit rate, between 0 and 1
+     */
+    double getHitRate() {
+        return this->hits + this->misses == 0 ? 0 : (double) this->hits / (this->hits + this->misses);
+    }
+
+    /**
+     * @brief Gets the number of times the cache was flushed
+     * 
+     * @return The number of flushes
+     */
+    unsigned long long getFlushes() {
+        return this->flushes;
+    }
+
+    /**
+     * @brief Gets the number of states built so far, counting again the states rebuilt after a flush
+     * 
+     * @return The number of states built
+     */
+    unsigned long long getBuiltStateCount() {
+        return this->built_states;
+    }
+
+    /**
+     * @brief Gets the number of states in the cache
+     * 
+     * @return The number of cached states
+     */
+    int getCachedStateCount() {
+        return this->table.size();
+    }
+
+    /**
+     * @brief Gets the largest number of states the cache holds
+     * 
+     * @return The capacity of the cache
+     */
+    size_t getCapacity() {
+        return this->max_states;
+    }
+};
\ No newline at end of file
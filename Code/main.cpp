@@ -7,30 +7,88 @@
 #include <iostream>
 #include "pugixml/pugixml.hpp"
 #include "algorithms.cpp"
+#include "alphabet.cpp"
+#include "jff.cpp"
+#include "subset.cpp"
+#include "lazyDfa.cpp"
+#include "bisimulation.cpp"
+#include "regex.cpp"
+#include "revuz.cpp"
+#include "incremental.cpp"
+#include "anytime.cpp"
+#include "cache.cpp"
+#include "equivalence.cpp"
+#include "product.cpp"
+#include "matcher.cpp"
+#include "parallelMatcher.cpp"
+#include "shuffleMatcher.cpp"
+#include "accelMatcher.cpp"
+#include "codegen.cpp"
+#include "staticDfa.cpp"
+#include "tokenizer.cpp"
+#include "wordCounter.cpp"
 #include <chrono>
+#include <memory>
+#include <iomanip>
 
 // #define BASE_PATH "./../" // Debug path
 #define BASE_PATH "./../../" // Execution path
 
-DFA loadDfaFromFile(bool* dfaNullFlag);
+#define CACHE_MAX_ENTRIES 256
+#define CACHE_MAX_BYTES (64ULL * 1024 * 1024)
+
+// Number of lexemes the tokenizer writes per call
+#define TOKENIZER_BATCH 4096
+
+// Sampled words longer than this are shown cut
+#define SAMPLE_PRINT_LIMIT 80
+
+DFA loadDfaFromFile(bool* dfaNullFlag, bisimulationMode nfaReduction);
 void exportDfaToFile(DFA dfa);
+void exportDfaToCppHeader(DFA dfa);
 DFA minimizeWithON2Algorithm(DFA dfa);
 DFA minimizeWithONLogNAlgorithm(DFA dfa);
+DFA minimizeOverSymbolClasses(DFA dfa, DFA (*minimizer)(DFA));
+DFA minimizeWithRevuzAlgorithm(DFA dfa);
+DFA minimizeWithBestAlgorithm(DFA dfa, DFA (*minimizer)(DFA), std::string algorithm, MinimizationCache* cache);
 DFA generateDfa(int n);
+void matchWordsFromFile(DFA dfa);
+void matchLargeFile(DFA dfa);
+void benchmarkMatchers(DFA dfa);
+void minimizeIntervalDfaFile();
+void matchWordsLazily(bisimulationMode nfaReduction);
+NFA reduceNfa(NFA nfa, bisimulationMode nfaReduction);
+DFA compileRegexFromInput(bool* dfaNullFlag, bisimulationMode nfaReduction);
+void buildDawgFromWordList();
+DFA editMinimalDfa(DFA dfa);
+DFA minimizeWithinBudget(DFA dfa);
+void minimizeTransducerFile();
+void tokenizeFile(DFA dfa);
+void distinguishStates(DFA dfa);
+void countAndSampleWords(DFA dfa);
 
 int main()
 {
     DFA dfa = DFA();
     bool dfaNullFlag = true;
     bool quit = false;
+    bool useCache = false;
+    bisimulationMode nfaReduction = BISIMULATION_NONE;
+    std::string reductionNames[] = {"none", "forward", "forward and backward"};
+    std::string s_base_path = BASE_PATH;
+    MinimizationCache cache = MinimizationCache(s_base_path + "Cache/", CACHE_MAX_ENTRIES, CACHE_MAX_BYTES);
 
     while (!quit) {
-        std::cout << "MENU:\n1. Load DFA file\n2. Export DFA\n3. Run O(n^2) Algorithm\n4. Run O(n log n) Algorithm\n5. Generate n states DFA\n0. Quit\nChoose option: ";
+        std::cout << "MENU:\n1. Load DFA file\n2. Export DFA\n3. Run O(n^2) Algorithm\n4. Run O(n log n) Algorithm\n5. Generate n states DFA\n6. " << (useCache ? "Disable" : "Enable") << " minimization cache\n7. Check equivalence with another DFA\n8. Combine with another DFA\n9. Complement DFA\n10. Match words from file\n11. Match whole file in parallel\n12. Benchmark matching engines\n13. Export DFA as C++ header\n14. Minimize range-labelled DFA file\n15. Match words from file against an NFA lazily\n16. Change NFA reduction before determinization (now: " << reductionNames[nfaReduction] << ")\n17. Compile regular expression\n18. Build minimal DFA from sorted word list\n19. Edit DFA keeping it minimal\n20. Minimize within a time budget\n21. Minimize Moore/Mealy machine file\n22. Tokenize file\n23. Find shortest word distinguishing two states\n24. Count and sample accepted words\n25. Run Revuz's Algorithm (acyclic DFAs)\n0. Quit\nChoose option: ";
         int option;
         std::cin >> option;
         switch (option) {
         case 1:
-            dfa = loadDfaFromFile(&dfaNullFlag);
+            try {
+                dfa = loadDfaFromFile(&dfaNullFlag, nfaReduction);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
             break;
         case 2:
             if (dfaNullFlag) {
@@ -46,7 +104,7 @@ int main()
             }
             try {
                 std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
-                dfa = minimizeWithON2Algorithm(dfa);
+                dfa = minimizeWithBestAlgorithm(dfa, minimizeWithON2Algorithm, "on2", useCache ? &cache : nullptr);
                 std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
                 std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n\n";
             } catch (const std::exception& e) {
@@ -60,7 +118,7 @@ int main()
             }
             try {
                 std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
-                dfa = minimizeWithONLogNAlgorithm(dfa);
+                dfa = minimizeWithBestAlgorithm(dfa, minimizeWithONLogNAlgorithm, "onlogn", useCache ? &cache : nullptr);
                 std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
                 std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n\n";
             } catch (const std::exception& e) {
@@ -78,6 +136,211 @@ int main()
                 std::cout << "\nInvalid number of states.\n\n";
             }
             break;
+        case 6:
+            useCache = !useCache;
+            std::cout << "\nMinimization cache " << (useCache ? "enabled" : "disabled") << " (" << cache.getEntryCount() << " entries, " << cache.getHits() << " hits, " << cache.getMisses() << " misses).\n\n";
+            break;
+        case 7: {
+            if (dfaNullFlag) {
+                std::cout << "\nNo DFA loaded yet.\n\n";
+                break;
+            }
+            bool otherNullFlag = true;
+            DFA other = loadDfaFromFile(&otherNullFlag, nfaReduction);
+            if (otherNullFlag) {
+                break;
+            }
+            std::vector<std::string> counterexample;
+            if (checkEquivalence(dfa, other, &counterexample)) {
+                std::cout << "The DFAs are equivalent.\n\n";
+            } else {
+                std::cout << "The DFAs are not equivalent. Shortest counterexample: " << wordToString(counterexample) << "\n\n";
+            }
+            break;
+        }
+        case 8: {
+            if (dfaNullFlag) {
+                std::cout << "\nNo DFA loaded yet.\n\n";
+                break;
+            }
+            bool otherNullFlag = true;
+            DFA other = loadDfaFromFile(&otherNullFlag, nfaReduction);
+            if (otherNullFlag) {
+                break;
+            }
+            std::cout << "Operation (1. Intersection, 2. Union, 3. Difference, 4. Symmetric difference): ";
+            int operation;
+            std::cin >> operation;
+            if (operation < 1 || operation > 4) {
+                std::cout << "\nInvalid operation.\n\n";
+                break;
+            }
+            std::cout << "Minimize the product? (1. Yes, 0. No): ";
+            int minimize;
+            std::cin >> minimize;
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            dfa = buildProduct(dfa, other, (productOperation) (operation - 1), minimize == 1);
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            std::cout << "Product built with " << dfa.getStates().size() << " states.\n";
+            std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n\n";
+            break;
+        }
+        case 9:
+            if (dfaNullFlag) {
+                std::cout << "\nNo DFA loaded yet.\n\n";
+                break;
+            }
+            dfa = complementDfa(dfa);
+            std::cout << "\nDFA complemented.\n\n";
+            break;
+        case 10:
+            if (dfaNullFlag) {
+                std::cout << "\nNo DFA loaded yet.\n\n";
+                break;
+            }
+            try {
+                matchWordsFromFile(dfa);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
+            break;
+        case 11:
+            if (dfaNullFlag) {
+                std::cout << "\nNo DFA loaded yet.\n\n";
+                break;
+            }
+            try {
+                matchLargeFile(dfa);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
+            break;
+        case 12:
+            if (dfaNullFlag) {
+                std::cout << "\nNo DFA loaded yet.\n\n";
+                break;
+            }
+            try {
+                benchmarkMatchers(dfa);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
+            break;
+        case 13:
+            if (dfaNullFlag) {
+                std::cout << "\nNo DFA loaded yet.\n\n";
+                break;
+            }
+            try {
+                exportDfaToCppHeader(dfa);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
+            break;
+        case 14:
+            try {
+                minimizeIntervalDfaFile();
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
+            break;
+        case 15:
+            try {
+                matchWordsLazily(nfaReduction);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
+            break;
+        case 16:
+            nfaReduction = (bisimulationMode) ((nfaReduction + 1) % 3);
+            std::cout << "\nNFA reduction before determinization: " << reductionNames[nfaReduction] << ".\n\n";
+            break;
+        case 17:
+            try {
+                dfa = compileRegexFromInput(&dfaNullFlag, nfaReduction);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
+            break;
+        case 18:
+            try {
+                buildDawgFromWordList();
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
+            break;
+        case 19:
+            if (dfaNullFlag) {
+                std::cout << "\nNo DFA loaded yet.\n\n";
+                break;
+            }
+            try {
+                dfa = editMinimalDfa(dfa);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
+            break;
+        case 20:
+            if (dfaNullFlag) {
+                std::cout << "\nNo DFA loaded yet.\n\n";
+                break;
+            }
+            try {
+                dfa = minimizeWithinBudget(dfa);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
+            break;
+        case 21:
+            try {
+                minimizeTransducerFile();
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
+            break;
+        case 22:
+            if (dfaNullFlag) {
+                std::cout << "\nNo DFA loaded yet.\n\n";
+                break;
+            }
+            try {
+                tokenizeFile(dfa);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
+            break;
+        case 23:
+            if (dfaNullFlag) {
+                std::cout << "\nNo DFA loaded yet.\n\n";
+                break;
+            }
+            distinguishStates(dfa);
+            break;
+        case 24:
+            if (dfaNullFlag) {
+                std::cout << "\nNo DFA loaded yet.\n\n";
+                break;
+            }
+            try {
+                countAndSampleWords(dfa);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
+            break;
+        case 25:
+            if (dfaNullFlag) {
+                std::cout << "\nNo DFA loaded yet.\n\n";
+                break;
+            }
+            try {
+                std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+                dfa = useCache ? cache.minimize(dfa, minimizeWithRevuzAlgorithm, "revuz") : minimizeWithRevuzAlgorithm(dfa);
+                std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+                std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n\n";
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << '\n';
+            }
+            break;
         default:
             quit = true;
             break;
@@ -91,9 +354,10 @@ int main()
  * @brief Loads a DFA from a file
  * 
  * @param dfaNullFlag Pointer to a flag that indicates if the DFA is null
+ * @param nfaReduction The bisimulation reduction run on a nondeterministic file before determinization
  * @return The DFA loaded from the file
  */
-DFA loadDfaFromFile(bool* dfaNullFlag) {
+DFA loadDfaFromFile(bool* dfaNullFlag, bisimulationMode nfaReduction) {
     std::cout << "File name to load: ";
     std::string file_name;
     std::cin >> file_name;
@@ -120,28 +384,36 @@ DFA loadDfaFromFile(bool* dfaNullFlag) {
     
     std::cout << "File loaded successfully.\n";
 
+    std::string type = file.child("structure").child_value("type");
+    if (type == "moore" || type == "mealy") {
+        std::cout << "\nThe file holds a " << type << " machine. Please minimize it as a Moore/Mealy machine file.\n\n";
+        *dfaNullFlag = true;
+        return DFA();
+    }
+
     std::cout << "Setting up DFA...\n";
 
     DFA dfa = DFA();
-    pugi::xml_node automaton = file.child("structure").child("automaton");
-
-    // Setting up states
-    for (pugi::xml_node node = automaton.child("state"); node; node = node.next_sibling("state")) {
-        std::string id = node.attribute("id").value();
-        dfa.addState(id);
-        if (node.child("initial")) {
-            dfa.setInitialState(id);
-        }
-        if (node.child("final")) {
-            dfa.addFinalState(id);
-        }
+    NFA nfa;
+    try {
+        nfa = parseJffNfa(file.child("structure").child("automaton"));
+    } catch (const std::exception& e) {
+        std::cout << "\n" << e.what() << "\n\n";
+        *dfaNullFlag = true;
+        return DFA();
     }
-
-    // Setting up transitions
-    for (pugi::xml_node node = automaton.child("transition"); node; node = node.next_sibling("transition")) {
-        std::string symbol = node.child_value("read");
-        dfa.addSymbol(symbol);
-        dfa.addTransition(node.child_value("from"), symbol, node.child_value("to"));
+    if (nfa.isDeterministic()) {
+        dfa = nfa.convertToDfa();
+    } else {
+        // The determinized DFA is left as built, so that the minimization algorithms can be compared on it
+        std::cout << "The automaton is nondeterministic (" << nfa.getStateCount() << " states, " << nfa.getTransitionCount() << " transitions), running the subset construction...\n";
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        nfa = reduceNfa(nfa, nfaReduction);
+        IndexedDFA subsets = determinize(nfa, SUBSET_MAX_STATES);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        std::cout << "Subset construction built " << subsets.getStateCount() << " states.\n";
+        std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n";
+        dfa = subsets.convertToDfa();
     }
 
     std::cout << "DFA successfully setted up.\n\n";
@@ -186,35 +458,505 @@ void exportDfaToFile(DFA dfa) {
     
     pugi::xml_node automaton = skeleton.child("structure").child("automaton");
 
-    // Setting up states
-    for (state s : dfa.getStates()) {
-        pugi::xml_node state = automaton.append_child("state");
-        state.append_attribute("id") = s.c_str();
-        state.append_attribute("name") = ("q" + s).c_str();
-        state.append_child("x").append_child(pugi::node_pcdata).set_value("0");
-        state.append_child("y").append_child(pugi::node_pcdata).set_value("0");
-        if (s == dfa.getInitialState()) {
-            state.append_child("initial");
+    appendDfaToJff(dfa, automaton);
+
+    skeleton.save_file(file_path.c_str());
+
+    std::cout << "\nDFA successfully exported to " + file_path + ".\n\n";
+}
+
+/**
+ * @brief Exports a DFA as a self-contained C++ header with a matcher
+ * 
+ * @param dfa The DFA to be exported
+ */
+void exportDfaToCppHeader(DFA dfa) {
+    std::cout << "File name to export: ";
+    std::string file_name;
+    std::cin >> file_name;
+
+    std::string s_base_path = BASE_PATH;
+    std::string file_path = s_base_path + "Output/" + file_name;
+
+    if (existsFile(file_path)) {
+        std::cout << "\nFile already exists.\n\n";
+        return;
+    }
+
+    std::cout << "Style (1. constexpr table, 2. switch/goto): ";
+    int style;
+    std::cin >> style;
+    if (style != 1 && style != 2) {
+        std::cout << "\nInvalid style.\n\n";
+        return;
+    }
+
+    std::cout << "Generating code...\n";
+
+    std::string name = file_name.substr(0, file_name.find('.'));
+    std::ofstream file(file_path);
+    file << generateCppHeader(dfa, name, style == 1 ? CODEGEN_TABLE : CODEGEN_SWITCH);
+    file.close();
+
+    std::cout << "\nDFA successfully exported to " + file_path + ".\n\n";
+}
+
+/**
+ * @brief Minimizes a DFA whose transitions are labelled with symbol ranges, such as "a-z" or "U+0080-U+10FFFF", and exports the result with range labels
+ */
+void minimizeIntervalDfaFile() {
+    std::cout << "File name to load: ";
+    std::string file_name;
+    std::cin >> file_name;
+    std::cout << "File name to export: ";
+    std::string output_name;
+    std::cin >> output_name;
+
+    std::string s_base_path = BASE_PATH;
+    std::string file_path = s_base_path + "Data/" + file_name;
+    std::string output_path = s_base_path + "Output/" + output_name;
+    std::string skeleton_path = s_base_path + "Data/skeleton.jff";
+
+    pugi::xml_document file;
+    if (!existsFile(file_path) || !file.load_file(file_path.c_str())) {
+        std::cout << "\nFile not found.\n\n";
+        return;
+    }
+    if (existsFile(output_path)) {
+        std::cout << "\nFile already exists.\n\n";
+        return;
+    }
+    pugi::xml_document skeleton;
+    if (!existsFile(skeleton_path) || !skeleton.load_file(skeleton_path.c_str())) {
+        std::cout << "\nSkeleton file not found. Please recreate it.\n\n";
+        return;
+    }
+
+    IntervalDFA dfa = parseJffIntervalAutomaton(file.child("structure").child("automaton"));
+    std::cout << "DFA loaded with " << dfa.getStateCount() << " states and " << dfa.getRangeCount() << " ranges.\n";
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    IntervalDFA minimal = dfa.minimize();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::cout << "Minimized to " << minimal.getStateCount() << " states and " << minimal.getRangeCount() << " ranges.\n";
+    std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n";
+
+    appendIntervalDfaToJff(minimal, skeleton.child("structure").child("automaton"));
+    skeleton.save_file(output_path.c_str());
+    std::cout << "\nDFA successfully exported to " + output_path + ".\n\n";
+}
+
+/**
+ * @brief Minimizes a Moore or Mealy machine file, refining on the outputs and the transitions at once, and exports the result with its outputs
+ */
+void minimizeTransducerFile() {
+    std::cout << "File name to load: ";
+    std::string file_name;
+    std::cin >> file_name;
+    std::cout << "File name to export: ";
+    std::string output_name;
+    std::cin >> output_name;
+
+    std::string s_base_path = BASE_PATH;
+    std::string file_path = s_base_path + "Data/" + file_name;
+    std::string output_path = s_base_path + "Output/" + output_name;
+    std::string skeleton_path = s_base_path + "Data/skeleton.jff";
+
+    pugi::xml_document file;
+    if (!existsFile(file_path) || !file.load_file(file_path.c_str())) {
+        std::cout << "\nFile not found.\n\n";
+        return;
+    }
+    if (existsFile(output_path)) {
+        std::cout << "\nFile already exists.\n\n";
+        return;
+    }
+    pugi::xml_document skeleton;
+    if (!existsFile(skeleton_path) || !skeleton.load_file(skeleton_path.c_str())) {
+        std::cout << "\nSkeleton file not found. Please recreate it.\n\n";
+        return;
+    }
+
+    Transducer machine = parseJffTransducer(file.child("structure"));
+    std::string type = machine.getType() == MACHINE_MOORE ? "Moore" : "Mealy";
+    std::cout << type << " machine loaded with " << machine.getDfa().getStateCount() << " reachable states.\n";
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    Transducer minimal = machine.minimize();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::cout << "Minimized to " << minimal.getDfa().getStateCount() << " states.\n";
+    std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n";
+
+    appendTransducerToJff(minimal, skeleton.child("structure"));
+    skeleton.save_file(output_path.c_str());
+    std::cout << "\n" << type << " machine successfully exported to " + output_path + ".\n\n";
+}
+
+/**
+ * @brief Runs a bisimulation reduction on an NFA, reporting how much it shrank
+ * 
+ * @param nfa The NFA
+ * @param nfaReduction The reduction to be run
+ * @return The reduced NFA
+ */
+NFA reduceNfa(NFA nfa, bisimulationMode nfaReduction) {
+    if (nfaReduction == BISIMULATION_NONE) {
+        return nfa;
+    }
+    NFA reduced = reduceByBisimulation(nfa, nfaReduction == BISIMULATION_FORWARD_BACKWARD);
+    std::cout << "Bisimulation reduced the NFA from " << nfa.getStateCount() << " to " << reduced.getStateCount() << " states.\n";
+    return reduced;
+}
+
+/**
+ * @brief Compiles a regular expression typed by the user into its minimal DFA, through the Glushkov automaton, the subset construction and Hopcroft's minimization
+ * 
+ * @param dfaNullFlag Pointer to a flag that indicates if the DFA is null
+ * @param nfaReduction The bisimulation reduction run on the Glushkov automaton before determinization
+ * @return The minimal DFA of the regular expression
+ */
+DFA compileRegexFromInput(bool* dfaNullFlag, bisimulationMode nfaReduction) {
+    std::cout << "Regular expression: ";
+    std::string pattern;
+    std::cin >> std::ws;
+    std::getline(std::cin, pattern);
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    NFA nfa = buildGlushkovNfa(pattern);
+    std::cout << "Glushkov automaton built with " << nfa.getStateCount() << " states and " << nfa.getTransitionCount() << " transitions.\n";
+    nfa = reduceNfa(nfa, nfaReduction);
+    IndexedDFA subsets = determinize(nfa, SUBSET_MAX_STATES);
+    IndexedDFA minimal = minimizeIndexedDfa(subsets);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::cout << "Subset construction built " << subsets.getStateCount() << " states, reduced to " << minimal.getStateCount() << " states.\n";
+    std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n\n";
+
+    *dfaNullFlag = false;
+    return minimal.convertToDfa();
+}
+
+/**
+ * @brief Builds the minimal DFA of a sorted word list, reading the file one line at a time and keeping the automaton minimal after every word, and writes it straight to a JFLAP file or, for a .bin name, to the binary form of DawgBuilder
+ */
+void buildDawgFromWordList() {
+    std::cout << "File name with one sorted word per line: ";
+    std::string file_name;
+    std::cin >> file_name;
+    std::cout << "File name to export (.jff or .bin): ";
+    std::string output_name;
+    std::cin >> output_name;
+
+    std::string s_base_path = BASE_PATH;
+    std::string output_path = s_base_path + "Output/" + output_name;
+    if (existsFile(output_path)) {
+        std::cout << "\nFile already exists.\n\n";
+        return;
+    }
+    bool binary = output_name.size() >= 4 && output_name.substr(output_name.size() - 4) == ".bin";
+    pugi::xml_document skeleton;
+    if (!binary) {
+        std::string skeleton_path = s_base_path + "Data/skeleton.jff";
+        if (!existsFile(skeleton_path) || !skeleton.load_file(skeleton_path.c_str())) {
+            std::cout << "\nSkeleton file not found. Please recreate it.\n\n";
+            return;
         }
-        if (dfa.isFinalState(s)) {
-            state.append_child("final");
+    }
+    std::ifstream file(s_base_path + "Data/" + file_name);
+    if (!file) {
+        std::cout << "\nFile not found.\n\n";
+        return;
+    }
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    DawgBuilder dawg = DawgBuilder();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.size() > 0 && line.back() == '\r') {
+            line.pop_back();
         }
+        dawg.addWord(line);
     }
+    dawg.finish();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::cout << dawg.getWordCount() << " words give a minimal DFA with " << dawg.getStateCount() << " states and " << dawg.getTransitionCount() << " transitions (at most " << dawg.getPeakStateCount() << " states in use).\n";
+    std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n";
 
-    // Setting up transitions
-    for (std::pair<const transition, state> const& it : dfa.getTransitions()) {
-        pugi::xml_node transition = automaton.append_child("transition");
-        const pugi::char_t* state1 = it.first.first.c_str();
-        const pugi::char_t* state2 = it.second.c_str();
-        const pugi::char_t* symbol = it.first.second.c_str();
-        transition.append_child("from").append_child(pugi::node_pcdata).set_value(state1);
-        transition.append_child("to").append_child(pugi::node_pcdata).set_value(state2);
-        transition.append_child("read").append_child(pugi::node_pcdata).set_value(symbol);
+    if (binary) {
+        std::ofstream output(output_path, std::ios::binary);
+        dawg.writeBinary(output);
+    } else {
+        appendDawgToJff(dawg, skeleton.child("structure").child("automaton"));
+        skeleton.save_file(output_path.c_str());
     }
+    std::cout << "\nDFA successfully exported to " + output_path + ".\n\n";
+}
 
-    skeleton.save_file(file_path.c_str());
+/**
+ * @brief Minimizes a DFA once and then applies edits typed by the user, each one followed by an incremental minimization that only looks at the states the edit affects
+ * 
+ * @param dfa The DFA to be edited
+ * @return The edited minimal DFA
+ */
+DFA editMinimalDfa(DFA dfa) {
+    IncrementalMinimalDFA editor = IncrementalMinimalDFA(IndexedDFA(dfa));
+    std::cout << "Minimal DFA with " << editor.getStateCount() << " states.\n";
+    bool done = false;
+    while (!done) {
+        std::cout << "EDIT:\n1. Add or change transition\n2. Remove transition\n3. Toggle final state\n0. Done\nChoose option: ";
+        int option;
+        std::cin >> option;
+        if (option < 1 || option > 3) {
+            done = true;
+            continue;
+        }
+        std::string from_name, symbol, to_name;
+        std::cout << "State: ";
+        std::cin >> from_name;
+        if (option != 3) {
+            std::cout << "Symbol: ";
+            std::cin >> symbol;
+        }
+        if (option == 1) {
+            std::cout << "Target state: ";
+            std::cin >> to_name;
+        }
+        int from = editor.getStateIndex(from_name);
+        int a = option == 3 ? 0 : editor.getSymbolIndex(symbol);
+        int to = option == 1 ? editor.getStateIndex(to_name) : NO_STATE;
+        if (from == NO_STATE || (option == 1 && to == NO_STATE)) {
+            std::cout << "\nState not found.\n\n";
+            continue;
+        }
+        if (a == -1) {
+            std::cout << "\nSymbol not found.\n\n";
+            continue;
+        }
 
-    std::cout << "\nDFA successfully exported to " + file_path + ".\n\n";
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        if (option == 3) {
+            editor.setFinalState(from, !editor.isFinalState(from));
+        } else {
+            editor.setTransition(from, a, to);
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        std::cout << "Minimal DFA with " << editor.getStateCount() << " states (" << editor.getLastAffectedCount() << " states affected).\n";
+        std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() << "us\n\n";
+    }
+    return editor.convertToIndexedDfa().convertToDfa();
+}
+
+/**
+ * @brief Minimizes a DFA for at most a given time, keeping the merges proven until then. The result always recognizes the same language, and it is minimal when the time was enough
+ * 
+ * @param dfa The DFA to be minimized
+ * @return The reduced DFA
+ */
+DFA minimizeWithinBudget(DFA dfa) {
+    std::cout << "Time budget in ms: ";
+    int milliseconds;
+    std::cin >> milliseconds;
+    if (milliseconds <= 0) {
+        std::cout << "\nInvalid time.\n\n";
+        return dfa;
+    }
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    AnytimeMinimizer minimizer = AnytimeMinimizer(IndexedDFA(dfa));
+    bool complete = minimizer.run(~0ULL, std::chrono::milliseconds(milliseconds), nullptr);
+    IndexedDFA result = minimizer.getResult();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::cout << (complete ? "Minimization complete" : "Time is up") << ": " << result.getStateCount() << " states after " << minimizer.getSteps() << " steps.\n";
+    std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n\n";
+    return result.convertToDfa();
+}
+
+/**
+ * @brief Splits a file into the longest tokens the DFA accepts, reading it in chunks of a given size, and reports how many tokens of each tag were found and the throughput
+ * 
+ * @param dfa The lexer DFA, whose accepting states are labelled with their token types
+ */
+void tokenizeFile(DFA dfa) {
+    std::cout << "File name to tokenize: ";
+    std::string file_name;
+    std::cin >> file_name;
+    std::cout << "Chunk size in KB: ";
+    int kilobytes;
+    std::cin >> kilobytes;
+    if (kilobytes <= 0) {
+        std::cout << "\nInvalid size.\n\n";
+        return;
+    }
+
+    std::string s_base_path = BASE_PATH;
+    std::ifstream file(s_base_path + "Data/" + file_name, std::ios::binary);
+    if (!file) {
+        std::cout << "\nFile not found.\n\n";
+        return;
+    }
+
+    Tokenizer tokenizer = Tokenizer(dfa);
+    std::vector<char> chunk((size_t) kilobytes * 1024);
+    std::vector<lexeme> batch(TOKENIZER_BATCH);
+    std::vector<unsigned long long> counts(tokenizer.getTagCount(), 0);
+    unsigned long long errors = 0;
+    unsigned long long bytes = 0;
+    auto count = [&]() {
+        size_t written;
+        while ((written = tokenizer.next(batch.data(), batch.size())) > 0) {
+            for (size_t i = 0; i < written; i++) {
+                if (batch[i].tag == LEXEME_ERROR) {
+                    errors++;
+                } else {
+                    counts[batch[i].tag]++;
+                }
+            }
+        }
+    };
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    while (file.read(chunk.data(), chunk.size()) || file.gcount() > 0) {
+        bytes += file.gcount();
+        tokenizer.feed(chunk.data(), (size_t) file.gcount());
+        count();
+    }
+    tokenizer.finish();
+    count();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    for (int tag = 0; tag < tokenizer.getTagCount(); tag++) {
+        std::cout << (tokenizer.getTagName(tag) == "" ? "(no label)" : tokenizer.getTagName(tag)) << ": " << counts[tag] << " tokens\n";
+    }
+    std::cout << "Unmatched bytes: " << errors << "\n";
+    std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms (" << computeGigabytesPerSecond(bytes, seconds) << " GB/s)\n\n";
+}
+
+/**
+ * @brief Reads two states of the DFA and shows a shortest word that leads only one of them to a final state
+ * 
+ * @param dfa The DFA
+ */
+void distinguishStates(DFA dfa) {
+    std::cout << "First state: ";
+    state p;
+    std::cin >> p;
+    std::cout << "Second state: ";
+    state q;
+    std::cin >> q;
+    std::set<state> states = dfa.getStates();
+    if (!has(states, p) || !has(states, q)) {
+        std::cout << "\nState not found.\n\n";
+        return;
+    }
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    std::vector<std::string> word;
+    bool distinguishable = findDistinguishingWord(dfa, p, q, &word);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    if (distinguishable) {
+        state s = p;
+        for (std::string symbol : word) {
+            s = s == DEAD_STATE ? DEAD_STATE : dfa.transite(s, symbol);
+        }
+        std::cout << "Shortest distinguishing word: " << wordToString(word) << " (accepted from " << (s != DEAD_STATE && dfa.isFinalState(s) ? p : q) << ")\n";
+    } else {
+        std::cout << "The states are equivalent.\n";
+    }
+    std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n\n";
+}
+
+/**
+ * @brief Counts the words of a length the DFA accepts and draws some of them uniformly at random
+ * 
+ * @param dfa The DFA
+ */
+void countAndSampleWords(DFA dfa) {
+    std::cout << "Word length: ";
+    long long length;
+    std::cin >> length;
+    std::cout << "Number of samples: ";
+    int samples;
+    std::cin >> samples;
+    if (length < 0 || samples < 0) {
+        std::cout << "\nInvalid number.\n\n";
+        return;
+    }
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    WordCounter counter = WordCounter(dfa, 0);
+    unsigned long long count = counter.countWords(length, COUNT_DEFAULT_MODULUS);
+    double magnitude = counter.countWordsLog2(length);
+    std::cout << "Accepted words of length " << length << ": " << count << " (mod " << COUNT_DEFAULT_MODULUS << ")";
+    if (magnitude == -INFINITY) {
+        std::cout << ", none.\n";
+    } else {
+        std::cout << ", about 2^" << std::fixed << std::setprecision(2) << magnitude << std::defaultfloat << std::setprecision(6) << ".\n";
+    }
+    if (samples > 0 && magnitude != -INFINITY) {
+        for (std::vector<std::string> word : counter.sampleWords(length, samples, std::chrono::steady_clock::now().time_since_epoch().count())) {
+            std::string text = wordToString(word);
+            std::cout << (text.size() > SAMPLE_PRINT_LIMIT ? text.substr(0, SAMPLE_PRINT_LIMIT) + "..." : text) << "\n";
+        }
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms\n\n";
+}
+
+/**
+ * @brief Matches every line of a file against an NFA with a lazy DFA, which only builds the DFA states the words reach and keeps them in a bounded cache, reporting the cache statistics
+ * 
+ * @param nfaReduction The bisimulation reduction run on the NFA first
+ */
+void matchWordsLazily(bisimulationMode nfaReduction) {
+    std::cout << "NFA file name to load: ";
+    std::string nfa_name;
+    std::cin >> nfa_name;
+    std::cout << "File name with one word per line: ";
+    std::string file_name;
+    std::cin >> file_name;
+    std::cout << "Cache size in KB: ";
+    int kilobytes;
+    std::cin >> kilobytes;
+    if (kilobytes <= 0) {
+        std::cout << "\nInvalid size.\n\n";
+        return;
+    }
+
+    std::string s_base_path = BASE_PATH;
+    NFA nfa = NFA();
+    if (!readNfaFromJff(s_base_path + "Data/" + nfa_name, &nfa)) {
+        std::cout << "\nFile not found.\n\n";
+        return;
+    }
+    std::ifstream file(s_base_path + "Data/" + file_name);
+    if (!file) {
+        std::cout << "\nFile not found.\n\n";
+        return;
+    }
+    std::vector<std::string> words;
+    unsigned long long bytes = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.size() > 0 && line.back() == '\r') {
+            line.pop_back();
+        }
+        bytes += line.size();
+        words.push_back(line);
+    }
+
+    nfa = reduceNfa(nfa, nfaReduction);
+    LazyDFA lazy = LazyDFA(nfa, (size_t) kilobytes * 1024);
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    size_t accepted = 0;
+    for (const std::string& word : words) {
+        accepted += lazy.matches(word) ? 1 : 0;
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    std::cout << accepted << " of " << words.size() << " words accepted.\n";
+    std::cout << "States built: " << lazy.getBuiltStateCount() << " (cache holds " << lazy.getCapacity() << ", " << lazy.getFlushes() << " flushes)\n";
+    std::cout << "Cache hit rate: " << lazy.getHitRate() * 100 << "% (" << lazy.getHits() << " hits, " << lazy.getMisses() << " misses)\n";
+    std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms (" << computeGigabytesPerSecond(bytes, seconds) << " GB/s)\n\n";
 }
 
 /**
@@ -225,7 +967,7 @@ void exportDfaToFile(DFA dfa) {
  * @return The minimized DFA
  */
 DFA minimizeWithON2Algorithm(DFA dfa) {
-    return myOn2Algorithm(dfa);
+    return minimizeOverSymbolClasses(dfa, myOn2Algorithm);
 }
 
 /**
@@ -236,7 +978,63 @@ DFA minimizeWithON2Algorithm(DFA dfa) {
  * @return The minimized DFA
  */
 DFA minimizeWithONLogNAlgorithm(DFA dfa) {
-    return blumOnLognAlgorithm(dfa);
+    return minimizeOverSymbolClasses(dfa, blumOnLognAlgorithm);
+}
+
+/**
+ * @brief Runs a minimization algorithm over one symbol per class of symbols with identical columns, then restores the whole alphabet. Such symbols never tell states apart, so the result is the same, but every loop over the alphabet gets shorter. The labels of the states are kept through the compression.
+ * 
+ * @param dfa The DFA to be minimized
+ * @param minimizer The minimization algorithm
+ * 
+ * @return The minimized DFA
+ */
+DFA minimizeOverSymbolClasses(DFA dfa, DFA (*minimizer)(DFA)) {
+    AlphabetPartition alphabet = AlphabetPartition(dfa);
+    if (alphabet.getClassCount() == alphabet.getSymbolCount()) {
+        return minimizer(dfa);
+    }
+    std::cout << "Alphabet compressed from " << alphabet.getSymbolCount() << " symbols to " << alphabet.getClassCount() << " classes.\n";
+    return alphabet.expand(minimizer(alphabet.compress(dfa)));
+}
+
+/**
+ * @brief Runs Revuz's algorithm, which minimizes an acyclic DFA in linear time by merging the states of each height. Labelled states are only merged with states of the same label.
+ * 
+ * @param dfa The DFA to be minimized, without cycles through states that reach a final state
+ * 
+ * @return The minimized DFA, its states named after their members like the other algorithms
+ */
+DFA minimizeWithRevuzAlgorithm(DFA dfa) {
+    IndexedDFA indexed = IndexedDFA(dfa);
+    if (indexed.getStateCount() == 0) {
+        return dfa;
+    }
+    std::vector<int> heights = computeStateHeights(indexed);
+    if (heights.size() == 0) {
+        throw std::invalid_argument("The DFA has a cycle, Revuz's algorithm only minimizes acyclic DFAs.");
+    }
+    return buildNamedQuotient(indexed, computeAcyclicEquivalenceClasses(indexed, heights)).convertToDfa();
+}
+
+/**
+ * @brief Minimizes a DFA with Revuz's algorithm when a topological pass finds it acyclic, and with the given algorithm otherwise, telling which one ran. The cache, when given, is keyed on the algorithm that actually ran.
+ * 
+ * @param dfa The DFA to be minimized
+ * @param minimizer The algorithm for DFAs with cycles
+ * @param algorithm The name of that algorithm in the cache
+ * @param cache The minimization cache, or nullptr to always minimize
+ * 
+ * @return The minimized DFA
+ */
+DFA minimizeWithBestAlgorithm(DFA dfa, DFA (*minimizer)(DFA), std::string algorithm, MinimizationCache* cache) {
+    IndexedDFA indexed = IndexedDFA(dfa);
+    if (indexed.getStateCount() > 0 && computeStateHeights(indexed).size() > 0) {
+        std::cout << "The DFA is acyclic, running Revuz's algorithm.\n";
+        minimizer = minimizeWithRevuzAlgorithm;
+        algorithm = "revuz";
+    }
+    return cache != nullptr ? cache->minimize(dfa, minimizer, algorithm) : minimizer(dfa);
 }
 
 /**
@@ -257,4 +1055,161 @@ DFA generateDfa(int n) {
         dfa.addTransition(std::to_string(i), "a", std::to_string((i + 1) % n));
     }
     return dfa;
+}
+
+/**
+ * @brief Matches every line of a file against a DFA, reporting how many were accepted and the throughput
+ * 
+ * @param dfa The DFA to be matched
+ */
+void matchWordsFromFile(DFA dfa) {
+    std::cout << "File name with one word per line: ";
+    std::string file_name;
+    std::cin >> file_name;
+
+    std::string s_base_path = BASE_PATH;
+    std::string file_path = s_base_path + "Data/" + file_name;
+
+    std::ifstream file(file_path);
+    if (!file) {
+        std::cout << "\nFile not found.\n\n";
+        return;
+    }
+    std::vector<std::string> words;
+    unsigned long long bytes = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.size() > 0 && line.back() == '\r') {
+            line.pop_back();
+        }
+        bytes += line.size();
+        words.push_back(line);
+    }
+
+    std::cout << "Compiling DFA...\n";
+    FastMatcher matcher = FastMatcher(dfa);
+    std::cout << "DFA compiled to " << matcher.getTableMatcher().getStateCount() << " states and " << matcher.getTableMatcher().getClassCount() << " byte classes (" << matcher.getBackendName() << " backend).\n";
+
+    std::unique_ptr<bool[]> results(new bool[words.size()]);
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    matcher.matchBatch(words.data(), words.size(), results.get());
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    size_t accepted = 0;
+    for (size_t i = 0; i < words.size(); i++) {
+        accepted += results[i] ? 1 : 0;
+    }
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    std::cout << accepted << " of " << words.size() << " words accepted.\n";
+    std::cout << "Total time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "ms (" << computeGigabytesPerSecond(bytes, seconds) << " GB/s)\n\n";
+}
+
+/**
+ * @brief Matches a whole file as a single input, serially, with self-loop acceleration and in parallel, reporting the throughput of each
+ * 
+ * @param dfa The DFA to be matched
+ */
+void matchLargeFile(DFA dfa) {
+    std::cout << "File name to match: ";
+    std::string file_name;
+    std::cin >> file_name;
+
+    std::string s_base_path = BASE_PATH;
+    std::string file_path = s_base_path + "Data/" + file_name;
+
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file) {
+        std::cout << "\nFile not found.\n\n";
+        return;
+    }
+    std::string input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    TableMatcher matcher = TableMatcher(dfa);
+    AcceleratedMatcher acceleratedMatcher = AcceleratedMatcher(matcher);
+    ParallelMatcher parallelMatcher = ParallelMatcher(matcher, 0, PARALLEL_AUTO);
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    bool serialResult = matcher.matches(input);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    double serialSeconds = std::chrono::duration<double>(end - begin).count();
+
+    begin = std::chrono::steady_clock::now();
+    bool acceleratedResult = acceleratedMatcher.matches(input);
+    end = std::chrono::steady_clock::now();
+    double acceleratedSeconds = std::chrono::duration<double>(end - begin).count();
+
+    begin = std::chrono::steady_clock::now();
+    bool parallelResult = parallelMatcher.matches(input.data(), input.size());
+    end = std::chrono::steady_clock::now();
+    double parallelSeconds = std::chrono::duration<double>(end - begin).count();
+
+    std::cout << "Input " << (parallelResult ? "accepted" : "rejected") << ".\n";
+    if (serialResult != parallelResult) {
+        std::cout << "Warning: the serial matcher " << (serialResult ? "accepted" : "rejected") << " it.\n";
+    }
+    if (acceleratedResult != parallelResult) {
+        std::cout << "Warning: the accelerated matcher " << (acceleratedResult ? "accepted" : "rejected") << " it.\n";
+    }
+    std::cout << "Serial: " << computeGigabytesPerSecond(input.size(), serialSeconds) << " GB/s\n";
+    std::cout << "Accelerated (" << acceleratedMatcher.getByteScanCount() << " states scanning for bytes, " << acceleratedMatcher.getSetScanCount() << " for byte sets): " << computeGigabytesPerSecond(input.size(), acceleratedSeconds) << " GB/s\n";
+    std::cout << "Parallel (" << parallelMatcher.getThreadCount() << " threads, " << (parallelMatcher.getMode() == PARALLEL_ENUMERATE ? "enumeration" : "speculation") << ", " << parallelMatcher.getFallbacks() << " fallbacks): " << computeGigabytesPerSecond(input.size(), parallelSeconds) << " GB/s\n\n";
+}
+
+/**
+ * @brief Measures the throughput of the matching engines on a random input over the DFA's alphabet
+ * 
+ * @param dfa The DFA to be matched
+ */
+void benchmarkMatchers(DFA dfa) {
+    std::cout << "Input size in MB: ";
+    int megabytes;
+    std::cin >> megabytes;
+    if (megabytes <= 0) {
+        std::cout << "\nInvalid size.\n\n";
+        return;
+    }
+
+    TableMatcher table = TableMatcher(dfa);
+    std::string symbols = "";
+    for (std::string symbol : dfa.getAlphabet()) {
+        symbols += symbol;
+    }
+    if (symbols.size() == 0) {
+        std::cout << "\nThe DFA has no symbols.\n\n";
+        return;
+    }
+    std::string input((size_t) megabytes << 20, ' ');
+    unsigned int seed = 12345;
+    for (char& c : input) {
+        seed = seed * 1103515245 + 12345;
+        c = symbols[(seed >> 16) % symbols.size()];
+    }
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    bool tableResult = table.matches(input);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::cout << "Table: " << computeGigabytesPerSecond(input.size(), std::chrono::duration<double>(end - begin).count()) << " GB/s\n";
+
+    AcceleratedMatcher accelerated = AcceleratedMatcher(table);
+    begin = std::chrono::steady_clock::now();
+    bool acceleratedResult = accelerated.matches(input);
+    end = std::chrono::steady_clock::now();
+    std::cout << "Accelerated: " << computeGigabytesPerSecond(input.size(), std::chrono::duration<double>(end - begin).count()) << " GB/s\n";
+    if (tableResult != acceleratedResult) {
+        std::cout << "Warning: the backends disagree.\n";
+    }
+
+    if (table.getStateCount() > SHUFFLE_MAX_STATES) {
+        std::cout << "Shuffle: not available, the DFA has more than " << SHUFFLE_MAX_STATES << " states.\n\n";
+        return;
+    }
+    ShuffleMatcher shuffle = ShuffleMatcher(table);
+    begin = std::chrono::steady_clock::now();
+    bool shuffleResult = shuffle.matches(input.data(), input.size());
+    end = std::chrono::steady_clock::now();
+    std::cout << "Shuffle" << (isShuffleSupported() ? "" : " (no SSSE3, scalar emulation)") << ": " << computeGigabytesPerSecond(input.size(), std::chrono::duration<double>(end - begin).count()) << " GB/s\n";
+    if (tableResult != shuffleResult) {
+        std::cout << "Warning: the backends disagree.\n";
+    }
+    std::cout << "\n";
 }
\ No newline at end of file
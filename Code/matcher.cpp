@@ -0,0 +1,251 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <stdexcept>
+#include <cstring>
+#include "indexedDfa.cpp"
+#include "jff.cpp"
+
+// Number of independent words walked together by TableMatcher::matchBatch
+#define MATCH_INTERLEAVE 4
+
+/**
+ * @brief A DFA compiled to a flat table for matching bytes. The bytes are grouped in classes with identical columns and every entry of the table holds the row of the next state, so one step is a single load. The dead state is row 0.
+ */
+class TableMatcher {
+private:
+    unsigned char byte_class[256];
+    int class_count;
+    std::vector<int> table;
+    std::vector<bool> accepting;
+    int initial_row;
+
+    /**
+     * @brief Walks a word from a row
+     * 
+     * @param row The row to start from
+     * @param data The bytes of the word
+     * @param length The number of bytes
+     * @return The row reached, 0 if the word fell in the dead state
+     */
+    int run(int row, const unsigned char* data, size_t length) const {
+        const int* t = this->table.data();
+        for (size_t i = 0; i < length && row != 0; i++) {
+            row = t[row + this->byte_class[data[i]]];
+        }
+        return row;
+    }
+
+public:
+    // Constructors
+    TableMatcher() {
+        std::memset(this->byte_class, 0, sizeof(this->byte_class));
+        this->class_count = 1;
+        this->table = std::vector<int>(1, 0);
+        this->accepting = std::vector<bool>(1, false);
+        this->initial_row = 0;
+    }
+
+    /**
+     * @brief Compiles a DFA. Every symbol must be a single byte
+     * 
+     * @param dfa The DFA to be compiled
+     */
+    TableMatcher(DFA dfa) : TableMatcher() {
+        IndexedDFA indexed = IndexedDFA(dfa);
+        for (std::string symbol : indexed.getSymbols()) {
+            if (symbol.size() != 1) {
+                throw std::invalid_argument("Symbol \"" + symbol + "\" is not a single byte, it can not be matched.");
+            }
+        }
+        if (indexed.getInitialState() == NO_STATE) {
+            return;
+        }
+
+        // Grouping the bytes with identical columns. State s is row s + 1, after the dead state
+        int n = indexed.getStateCount() + 1;
+        std::map<std::vector<int>, int> classes;
+        std::vector<std::vector<int>> columns;
+        for (int b = 0; b < 256; b++) {
+            std::vector<int> column(n, 0);
+            int a = indexed.getSymbolIndex(std::string(1, (char) b));
+            for (int s = 0; a != -1 && s < indexed.getStateCount(); s++) {
+                column[s + 1] = indexed.transite(s, a) + 1;
+            }
+            auto it = classes.find(column);
+            if (it == classes.end()) {
+                it = classes.insert(std::make_pair(column, (int) columns.size())).first;
+                columns.push_back(column);
+            }
+            this->byte_class[b] = (unsigned char) it->second;
+        }
+
+        this->class_count = (int) columns.size();
+        this->table = std::vector<int>((size_t) n * this->class_count);
+        this->accepting = std::vector<bool>(n, false);
+        for (int s = 0; s < n; s++) {
+            for (int c = 0; c < this->class_count; c++) {
+                this->table[(size_t) s * this->class_count + c] = columns[c][s] * this->class_count;
+            }
+            this->accepting[s] = s > 0 && indexed.isFinalState(s - 1);
+        }
+        this->initial_row = (indexed.getInitialState() + 1) * this->class_count;
+    }
+
+    /**
+     * @brief Compiles the DFA of an exported JFLAP file
+     * 
+     * @param file_path The path of the file
+     * @return The compiled DFA
+     */
+    static TableMatcher fromJffFile(std::string file_path) {
+        DFA dfa;
+        if (!readDfaFromJff(file_path, &dfa)) {
+            throw std::runtime_error("Could not read " + file_path + ".");
+        }
+        return TableMatcher(dfa);
+    }
+
+    // Matching
+    /**
+     * @brief Checks if the DFA accepts a word
+     * 
+     * @param data The bytes of the word
+     * @param length The number of bytes
+     * @return true if the word is accepted. false otherwise
+     */
+    bool matches(const char* data, size_t length) const {
+        int row = this->run(this->initial_row, (const unsigned char*) data, length);
+        return this->accepting[row / this->class_count];
+    }
+
+    /**
+     * @brief Checks if the DFA accepts a word
+     * 
+     * @param word The word
+     * @return true if the word is accepted. false otherwise
+     */
+    bool matches(const std::string& word) const {
+        return this->matches(word.data(), word.size());
+    }
+
+    /**
+     * @brief Checks many words. MATCH_INTERLEAVE words are walked together, one byte of each per step, so the table loads of independent words overlap instead of waiting for each other
+     * 
+     * @param words The words
+     * @param count The number of words
+     * @param results Where the result of each word is written
+     */
+    void matchBatch(const std::string* words, size_t count, bool* results) const {
+        const int* t = this->table.data();
+        size_t w = 0;
+        for (; w + MATCH_INTERLEAVE <= count; w += MATCH_INTERLEAVE) {
+            const unsigned char* data[MATCH_INTERLEAVE];
+            int rows[MATCH_INTERLEAVE];
+            size_t common = words[w].size();
+            for (int j = 0; j < MATCH_INTERLEAVE; j++) {
+                data[j] = (const unsigned char*) words[w + j].data();
+                rows[j] = this->initial_row;
+                common = std::min(common, words[w + j].size());
+            }
+            for (size_t i = 0; i < common; i++) {
+                for (int j = 0; j < MATCH_INTERLEAVE; j++) {
+                    rows[j] = t[rows[j] + this->byte_class[data[j][i]]];
+                }
+            }
+            for (int j = 0; j < MATCH_INTERLEAVE; j++) {
+                int row = this->run(rows[j], data[j] + common, words[w + j].size() - common);
+                results[w + j] = this->accepting[row / this->class_count];
+            }
+        }
+        for (; w < count; w++) {
+            results[w] = this->matches(words[w]);
+        }
+    }
+
+    /**
+     * @brief Walks bytes from a row of the table, stopping early at the dead state
+     * 
+     * @param row The row to start from
+     * @param data The bytes
+     * @param length The number of bytes
+     * @return The row reached
+     */
+    int runFromRow(int row, const char* data, size_t length) const {
+        return this->run(row, (const unsigned char*) data, length);
+    }
+
+    // TableMatcher Information
+    /**
+     * @brief Gets the row of the initial state
+     * 
+     * @return The row of the initial state
+     */
+    int getInitialRow() const {
+        return this->initial_row;
+    }
+
+    /**
+     * @brief Checks if the state of a row is accepting
+     * 
+     * @param row The row
+     * @return true if the state is accepting. false otherwise
+     */
+    bool isAcceptingRow(int row) const {
+        return this->accepting[row / this->class_count];
+    }
+
+    /**
+     * @brief Gets the table. The entry row + byte class holds the row of the next state
+     * 
+     * @return The table
+     */
+    const int* getTable() const {
+        return this->table.data();
+    }
+
+    /**
+     * @brief Gets the class of every byte
+     * 
+     * @return The 256 byte classes
+     */
+    const unsigned char* getByteClasses() const {
+        return this->byte_class;
+    }
+
+    /**
+     * @brief Gets the number of states, the dead state included
+     * 
+     * @return The number of states
+     */
+    int getStateCount() const {
+        return (int) this->accepting.size();
+    }
+
+    /**
+     * @brief Gets the number of byte classes
+     * 
+     * @return The number of byte classes
+     */
+    int getClassCount() const {
+        return this->class_count;
+    }
+};
+
+/**
+ * @brief Computes a throughput
+ * 
+ * @param bytes The number of bytes processed
+ * @param seconds The time spent
+ * @return The throughput in GB/s
+ */
+double computeGigabytesPerSecond(unsigned long long bytes, double seconds) {
+    if (seconds <= 0) {
+        return 0;
+    }
+    return bytes / seconds / 1e9;
+}
\ No newline at end of file
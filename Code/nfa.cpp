@@ -0,0 +1,345 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "indexedDfa.cpp"
+
+// The symbol index of an ε-transition
+#define EPSILON -1
+// The label number of the states without a label
+#define NO_LABEL 0
+
+/**
+ * @brief A Nondeterministic Finite Automaton with ε-transitions whose states and symbols are numbered. Every state keeps its list of (symbol, target) moves, so a state may have several targets for the same symbol, and its list of ε-moves. States may carry labels, such as token types, numbered by order of first use: a smaller number means a higher priority when a set of states is merged into one.
+ */
+class NFA {
+private:
+    std::vector<std::string> symbols;
+    std::vector<state> names;
+    std::vector<std::vector<std::pair<int, int>>> moves;
+    std::vector<std::vector<int>> epsilon_moves;
+    std::vector<bool> final_states;
+    std::vector<int> initial_states;
+    std::vector<int> labels;
+    std::vector<std::string> label_names;
+
+public:
+    // Constructors
+    NFA() {
+        this->symbols = std::vector<std::string>();
+        this->names = std::vector<state>();
+        this->moves = std::vector<std::vector<std::pair<int, int>>>();
+        this->epsilon_moves = std::vector<std::vector<int>>();
+        this->final_states = std::vector<bool>();
+        this->initial_states = std::vector<int>();
+        this->labels = std::vector<int>();
+        this->label_names = std::vector<std::string>(1, "");
+    }
+
+    NFA(std::vector<std::string> symbols) : NFA() {
+        this->symbols = symbols;
+    }
+
+    /**
+     * @brief Builds the NFA with the same states, labels and transitions of a DFA. Only the reachable states are kept, numbered like IndexedDFA
+     * 
+     * @param dfa The DFA
+     */
+    NFA(DFA dfa) : NFA() {
+        IndexedDFA indexed = IndexedDFA(dfa);
+        this->symbols = indexed.getSymbols();
+        for (int s = 0; s < indexed.getStateCount(); s++) {
+            this->addState(indexed.getStateName(s), indexed.isFinalState(s));
+            this->setStateLabel(s, this->addLabel(indexed.getStateLabel(s)));
+        }
+        for (int s = 0; s < indexed.getStateCount(); s++) {
+            for (int a = 0; a < indexed.getSymbolCount(); a++) {
+                if (indexed.transite(s, a) != NO_STATE) {
+                    this->addTransition(s, a, indexed.transite(s, a));
+                }
+            }
+        }
+        if (indexed.getInitialState() != NO_STATE) {
+            this->addInitialState(indexed.getInitialState());
+        }
+    }
+
+    // NFA Creation
+    /**
+     * @brief Adds a state without transitions
+     * 
+     * @param name The name of the state
+     * @param is_final Whether the state is final
+     * @return The index of the new state
+     */
+    int addState(state name, bool is_final) {
+        this->names.push_back(name);
+        this->final_states.push_back(is_final);
+        this->moves.push_back(std::vector<std::pair<int, int>>());
+        this->epsilon_moves.push_back(std::vector<int>());
+        this->labels.push_back(NO_LABEL);
+        return (int) this->names.size() - 1;
+    }
+
+    /**
+     * @brief Adds a transition. Repeated transitions are kept only once
+     * 
+     * @param from The index of the state from which the transition starts
+     * @param symbol The index of the symbol that triggers the transition, or EPSILON
+     * @param to The index of the state to which the transition goes
+     */
+    void addTransition(int from, int symbol, int to) {
+        if (symbol == EPSILON) {
+            std::vector<int>& list = this->epsilon_moves[from];
+            auto it = std::lower_bound(list.begin(), list.end(), to);
+            if (it == list.end() || *it != to) {
+                list.insert(it, to);
+            }
+            return;
+        }
+        std::vector<std::pair<int, int>>& list = this->moves[from];
+        std::pair<int, int> move = std::make_pair(symbol, to);
+        auto it = std::lower_bound(list.begin(), list.end(), move);
+        if (it == list.end() || *it != move) {
+            list.insert(it, move);
+        }
+    }
+
+    /**
+     * @brief Adds an initial state. An NFA may have several of them
+     * 
+     * @param s The index of the state
+     */
+    void addInitialState(int s) {
+        if (std::find(this->initial_states.begin(), this->initial_states.end(), s) == this->initial_states.end()) {
+            this->initial_states.push_back(s);
+        }
+    }
+
+    /**
+     * @brief Sets whether a state is final
+     * 
+     * @param s The index of the state
+     * @param is_final Whether the state is final
+     */
+    void setFinalState(int s, bool is_final) {
+        this->final_states[s] = is_final;
+    }
+
+    /**
+     * @brief Gets the number of a label, numbering it after the ones already used when it is new
+     * 
+     * @param name The label, or an empty string for none
+     * @return The number of the label, NO_LABEL for the empty string
+     */
+    int addLabel(std::string name) {
+        auto it = std::find(this->label_names.begin(), this->label_names.end(), name);
+        if (it != this->label_names.end()) {
+            return (int) (it - this->label_names.begin());
+        }
+        this->label_names.push_back(name);
+        return (int) this->label_names.size() - 1;
+    }
+
+    /**
+     * @brief Sets the label of a state
+     * 
+     * @param s The index of the state
+     * @param label The number of the label, given by addLabel, or NO_LABEL
+     */
+    void setStateLabel(int s, int label) {
+        this->labels[s] = label;
+    }
+
+    // NFA Information
+    /**
+     * @brief Gets the moves of a state with symbols, sorted by symbol then target
+     * 
+     * @param s The index of the state
+     * @return The (symbol, target) pairs
+     */
+    const std::vector<std::pair<int, int>>& getMoves(int s) const {
+        return this->moves[s];
+    }
+
+    /**
+     * @brief Gets the targets of the ε-transitions of a state
+     * 
+     * @param s The index of the state
+     * @return The targets, sorted
+     */
+    const std::vector<int>& getEpsilonMoves(int s) const {
+        return this->epsilon_moves[s];
+    }
+
+    /**
+     * @brief Gets the initial states
+     * 
+     * @return The indexes of the initial states
+     */
+    const std::vector<int>& getInitialStates() const {
+        return this->initial_states;
+    }
+
+    /**
+     * @brief Checks if a state is final
+     * 
+     * @param s The index of the state
+     * @return true if the state is final. false otherwise
+     */
+    bool isFinalState(int s) const {
+        return this->final_states[s];
+    }
+
+    /**
+     * @brief Gets the label of a state
+     * 
+     * @param s The index of the state
+     * @return The number of the label, or NO_LABEL
+     */
+    int getStateLabel(int s) const {
+        return this->labels[s];
+    }
+
+    /**
+     * @brief Gets the name of a label
+     * 
+     * @param label The number of the label
+     * @return The label, or an empty string for NO_LABEL
+     */
+    const std::string& getLabelName(int label) const {
+        return this->label_names[label];
+    }
+
+    /**
+     * @brief Gets the names of the labels, in priority order. The first one is the empty string of NO_LABEL
+     * 
+     * @return The labels
+     */
+    const std::vector<std::string>& getLabelNames() const {
+        return this->label_names;
+    }
+
+    /**
+     * @brief Checks if any label was used
+     * 
+     * @return true if the NFA has labels. false otherwise
+     */
+    bool hasLabels() const {
+        return this->label_names.size() > 1;
+    }
+
+    /**
+     * @brief Gets the number of states
+     * 
+     * @return The number of states
+     */
+    int getStateCount() const {
+        return (int) this->names.size();
+    }
+
+    /**
+     * @brief Gets the number of symbols of the alphabet, ε excluded
+     * 
+     * @return The number of symbols
+     */
+    int getSymbolCount() const {
+        return (int) this->symbols.size();
+    }
+
+    /**
+     * @brief Gets the total number of transitions, ε-transitions included
+     * 
+     * @return The number of transitions
+     */
+    size_t getTransitionCount() const {
+        size_t count = 0;
+        for (int s = 0; s < this->getStateCount(); s++) {
+            count += this->moves[s].size() + this->epsilon_moves[s].size();
+        }
+        return count;
+    }
+
+    /**
+     * @brief Gets the name of a state
+     * 
+     * @param s The index of the state
+     * @return The name of the state
+     */
+    state getStateName(int s) const {
+        return this->names[s];
+    }
+
+    /**
+     * @brief Gets a symbol of the alphabet
+     * 
+     * @param a The index of the symbol
+     * @return The symbol
+     */
+    std::string getSymbol(int a) const {
+        return this->symbols[a];
+    }
+
+    /**
+     * @brief Gets the alphabet, sorted and without ε
+     * 
+     * @return The symbols of the alphabet
+     */
+    const std::vector<std::string>& getSymbols() const {
+        return this->symbols;
+    }
+
+    /**
+     * @brief Checks if the NFA is in fact deterministic: at most one initial state, no ε-transitions and at most one target per state and symbol
+     * 
+     * @return true if the NFA is deterministic. false otherwise
+     */
+    bool isDeterministic() const {
+        if (this->initial_states.size() > 1) {
+            return false;
+        }
+        for (int s = 0; s < this->getStateCount(); s++) {
+            if (this->epsilon_moves[s].size() > 0) {
+                return false;
+            }
+            for (size_t i = 1; i < this->moves[s].size(); i++) {
+                if (this->moves[s][i].first == this->moves[s][i - 1].first) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Convert a deterministic NFA to a DFA, using the state names
+     * 
+     * @return The DFA with the same states, labels and transitions
+     */
+    DFA convertToDfa() const {
+        DFA dfa = DFA();
+        for (std::string symbol : this->symbols) {
+            dfa.addSymbol(symbol);
+        }
+        for (int s = 0; s < this->getStateCount(); s++) {
+            dfa.addState(this->names[s]);
+            if (this->final_states[s]) {
+                dfa.addFinalState(this->names[s]);
+            }
+            dfa.setStateLabel(this->names[s], this->label_names[this->labels[s]]);
+            for (std::pair<int, int> move : this->moves[s]) {
+                dfa.addTransition(this->names[s], this->symbols[move.first], this->names[move.second]);
+            }
+        }
+        if (this->initial_states.size() > 0) {
+            dfa.setInitialState(this->names[this->initial_states[0]]);
+        }
+        return dfa;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,222 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <thread>
+#include "shuffleMatcher.cpp"
+
+// Inputs shorter than this per thread are matched serially
+#define PARALLEL_MIN_CHUNK (1 << 16)
+// Automata up to this number of states are enumerated from every state in PARALLEL_AUTO mode
+#define PARALLEL_ENUMERATION_LIMIT 16
+// Bytes between two merges of the enumerated states that converged
+#define PARALLEL_CONVERGENCE_INTERVAL 64
+// Bytes before a chunk used to guess its start state when speculating
+#define PARALLEL_LOOKBACK 256
+
+/**
+ * @brief How the chunks after the first one are simulated
+ */
+enum parallelMode {
+    PARALLEL_AUTO,
+    PARALLEL_ENUMERATE,
+    PARALLEL_SPECULATE
+};
+
+/**
+ * @brief Matches one large input with several threads. The input is cut in chunks and every chunk is simulated on its own thread, either from every state (giving a state to state mapping) or from a speculated start state. The chunks are then combined in order by composing the mappings, re-running a chunk serially when its speculation was wrong.
+ */
+class ParallelMatcher {
+private:
+    TableMatcher matcher;
+    std::shared_ptr<ShuffleMatcher> shuffle;
+    int thread_count;
+    parallelMode mode;
+    int fallbacks;
+
+    /**
+     * @brief Simulates a chunk from every state. Small DFAs use the shuffle backend, which advances all states at once. Otherwise start states whose runs reach the same state are merged every PARALLEL_CONVERGENCE_INTERVAL bytes, so the work shrinks as the runs converge
+     * 
+     * @param data The bytes of the chunk
+     * @param length The number of bytes
+     * @return The row reached from each state, indexed by state (row / class count)
+     */
+    std::vector<int> mapChunk(const unsigned char* data, size_t length) const {
+        if (this->shuffle) {
+            alignas(16) unsigned char states[SHUFFLE_MAX_STATES];
+            this->shuffle->mapAll((const char*) data, length, states);
+            std::vector<int> mapping(this->matcher.getStateCount());
+            for (int s = 0; s < this->matcher.getStateCount(); s++) {
+                mapping[s] = states[s] * this->matcher.getClassCount();
+            }
+            return mapping;
+        }
+
+        const int* table = this->matcher.getTable();
+        const unsigned char* classes = this->matcher.getByteClasses();
+        int class_count = this->matcher.getClassCount();
+        int n = this->matcher.getStateCount();
+
+        // active holds distinct rows, owner[s] is the index in active of the run started at state s
+        std::vector<int> active;
+        std::vector<int> owner(n, 0);
+        for (int s = 0; s < n; s++) {
+            owner[s] = s;
+            active.push_back(s * class_count);
+        }
+        std::vector<int> seen(n, -1);
+        std::vector<int> remap;
+        size_t position = 0;
+        while (position < length && active.size() > 1) {
+            size_t block = std::min((size_t) PARALLEL_CONVERGENCE_INTERVAL, length - position);
+            for (size_t i = position; i < position + block; i++) {
+                int c = classes[data[i]];
+                for (int& row : active) {
+                    row = table[row + c];
+                }
+            }
+            position += block;
+
+            // Merging the runs that reached the same state
+            std::vector<int> merged;
+            remap.assign(active.size(), 0);
+            for (size_t j = 0; j < active.size(); j++) {
+                int s = active[j] / class_count;
+                if (seen[s] == -1) {
+                    seen[s] = (int) merged.size();
+                    merged.push_back(active[j]);
+                }
+                remap[j] = seen[s];
+            }
+            for (int row : merged) {
+                seen[row / class_count] = -1;
+            }
+            for (int s = 0; s < n; s++) {
+                owner[s] = remap[owner[s]];
+            }
+            active = merged;
+        }
+        if (position < length) {
+            active[0] = this->matcher.runFromRow(active[0], (const char*) data + position, length - position);
+        }
+
+        std::vector<int> mapping(n);
+        for (int s = 0; s < n; s++) {
+            mapping[s] = active[owner[s]];
+        }
+        return mapping;
+    }
+
+public:
+    // Constructors
+    /**
+     * @brief Prepares a parallel matcher
+     * 
+     * @param matcher The compiled DFA
+     * @param thread_count The number of threads, 0 to use one per hardware thread
+     * @param mode How the chunks after the first one are simulated
+     */
+    ParallelMatcher(TableMatcher matcher, int thread_count, parallelMode mode) {
+        this->matcher = matcher;
+        this->thread_count = thread_count > 0 ? thread_count : std::max(1, (int) std::thread::hardware_concurrency());
+        this->mode = mode;
+        if (this->mode == PARALLEL_AUTO) {
+            this->mode = matcher.getStateCount() <= PARALLEL_ENUMERATION_LIMIT ? PARALLEL_ENUMERATE : PARALLEL_SPECULATE;
+        }
+        this->fallbacks = 0;
+        if (matcher.getStateCount() <= SHUFFLE_MAX_STATES && isShuffleSupported()) {
+            this->shuffle = std::make_shared<ShuffleMatcher>(matcher);
+        }
+    }
+
+    // Matching
+    /**
+     * @brief Checks if the DFA accepts an input
+     * 
+     * @param data The bytes of the input
+     * @param length The number of bytes
+     * @return true if the input is accepted. false otherwise
+     */
+    bool matches(const char* data, size_t length) {
+        this->fallbacks = 0;
+        int chunk_count = (int) std::min((size_t) this->thread_count, length / PARALLEL_MIN_CHUNK);
+        if (chunk_count <= 1) {
+            return this->matcher.isAcceptingRow(this->matcher.runFromRow(this->matcher.getInitialRow(), data, length));
+        }
+
+        size_t chunk_length = length / chunk_count;
+        std::vector<size_t> starts(chunk_count + 1);
+        for (int i = 0; i <= chunk_count; i++) {
+            starts[i] = i == chunk_count ? length : i * chunk_length;
+        }
+
+        // Chunk 0 always starts from the initial state. The others are enumerated or speculated
+        std::vector<std::vector<int>> mappings(chunk_count);
+        std::vector<int> speculated(chunk_count), reached(chunk_count);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < chunk_count; i++) {
+            threads.push_back(std::thread([&, i]() {
+                const char* chunk = data + starts[i];
+                size_t size = starts[i + 1] - starts[i];
+                if (i == 0) {
+                    speculated[i] = this->matcher.getInitialRow();
+                    reached[i] = this->matcher.runFromRow(speculated[i], chunk, size);
+                } else if (this->mode == PARALLEL_ENUMERATE) {
+                    mappings[i] = this->mapChunk((const unsigned char*) chunk, size);
+                } else {
+                    size_t lookback = std::min((size_t) PARALLEL_LOOKBACK, starts[i]);
+                    speculated[i] = this->matcher.runFromRow(this->matcher.getInitialRow(), chunk - lookback, lookback);
+                    reached[i] = this->matcher.runFromRow(speculated[i], chunk, size);
+                }
+            }));
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        // Composing the chunks in order
+        int row = reached[0];
+        for (int i = 1; i < chunk_count; i++) {
+            if (this->mode == PARALLEL_ENUMERATE) {
+                row = mappings[i][row / this->matcher.getClassCount()];
+            } else if (row == speculated[i]) {
+                row = reached[i];
+            } else {
+                this->fallbacks++;
+                row = this->matcher.runFromRow(row, data + starts[i], starts[i + 1] - starts[i]);
+            }
+        }
+        return this->matcher.isAcceptingRow(row);
+    }
+
+    // ParallelMatcher Information
+    /**
+     * @brief Gets the number of chunks that were re-run serially by the last match because their speculation was wrong
+     * 
+     * @return The number of fallbacks
+     */
+    int getFallbacks() {
+        return this->fallbacks;
+    }
+
+    /**
+     * @brief Gets the mode used for the chunks
+     * 
+     * @return PARALLEL_ENUMERATE or PARALLEL_SPECULATE
+     */
+    parallelMode getMode() {
+        return this->mode;
+    }
+
+    /**
+     * @brief Gets the number of threads
+     * 
+     * @return The number of threads
+     */
+    int getThreadCount() {
+        return this->thread_count;
+    }
+};
\ No newline at end of file
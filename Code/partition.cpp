@@ -0,0 +1,363 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <vector>
+#include <numeric>
+#include <map>
+#include <set>
+#include "indexedDfa.cpp"
+
+/**
+ * @brief Gets the labels of the initial partition. Without state labels it is the usual {non-final, final}, otherwise the states are also split by their labels, so each pair of finality and label is a block of its own
+ * 
+ * @param dfa The DFA
+ * @return 0 for the non-final states without a label, 1 for the final ones without a label and a number from 2 on for each other pair of finality and label
+ */
+std::vector<int> getAcceptanceLabels(const IndexedDFA& dfa) {
+    std::vector<int> labels(dfa.getStateCount());
+    std::map<std::pair<bool, std::string>, int> numbers;
+    numbers[std::make_pair(false, std::string())] = 0;
+    numbers[std::make_pair(true, std::string())] = 1;
+    for (int s = 0; s < dfa.getStateCount(); s++) {
+        auto it = numbers.insert(std::make_pair(std::make_pair(dfa.isFinalState(s), dfa.getStateLabel(s)), (int) numbers.size())).first;
+        labels[s] = it->second;
+    }
+    return labels;
+}
+
+/**
+ * @brief A partition of the elements 0..n-1 that can be refined in place. The elements are kept in an array where every block is a contiguous range, so marking an element moves it to the front of its block and splitting a block takes time proportional to its marked elements
+ */
+class RefinablePartition {
+private:
+    std::vector<int> elements;
+    std::vector<int> location;
+    std::vector<int> block_of;
+    std::vector<int> first;
+    std::vector<int> end;
+    std::vector<int> marked;
+    std::vector<int> touched;
+
+public:
+    // Constructors
+    /**
+     * @brief Creates the partition with one block per label, the blocks ordered by label
+     * 
+     * @param labels One label per element
+     */
+    RefinablePartition(const std::vector<int>& labels) {
+        int n = (int) labels.size();
+        this->elements = std::vector<int>(n);
+        std::iota(this->elements.begin(), this->elements.end(), 0);
+        std::stable_sort(this->elements.begin(), this->elements.end(), [&](int x, int y) { return labels[x] < labels[y]; });
+        this->location = std::vector<int>(n);
+        this->block_of = std::vector<int>(n);
+        for (int i = 0; i < n; i++) {
+            if (i == 0 || labels[this->elements[i]] != labels[this->elements[i - 1]]) {
+                this->first.push_back(i);
+                this->end.push_back(i);
+                this->marked.push_back(0);
+            }
+            this->location[this->elements[i]] = i;
+            this->block_of[this->elements[i]] = (int) this->first.size() - 1;
+            this->end.back() = i + 1;
+        }
+    }
+
+    // RefinablePartition Operations
+    /**
+     * @brief Marks an element, moving it to the marked front of its block
+     * 
+     * @param e The element
+     */
+    void mark(int e) {
+        int b = this->block_of[e];
+        int marked_end = this->first[b] + this->marked[b];
+        if (this->location[e] < marked_end) {
+            return;
+        }
+        int other = this->elements[marked_end];
+        std::swap(this->elements[this->location[e]], this->elements[marked_end]);
+        this->location[other] = this->location[e];
+        this->location[e] = marked_end;
+        if (this->marked[b] == 0) {
+            this->touched.push_back(b);
+        }
+        this->marked[b]++;
+    }
+
+    /**
+     * @brief Splits every block that was only partly marked, moving its marked elements to a new block, and clears the marks
+     * 
+     * @param splits Receives one (block, new block) pair per split
+     */
+    void split(std::vector<std::pair<int, int>>& splits) {
+        splits.clear();
+        for (int b : this->touched) {
+            if (this->marked[b] == this->end[b] - this->first[b]) {
+                this->marked[b] = 0;
+                continue;
+            }
+            int nb = (int) this->first.size();
+            this->first.push_back(this->first[b]);
+            this->end.push_back(this->first[b] + this->marked[b]);
+            this->marked.push_back(0);
+            this->first[b] = this->end[nb];
+            this->marked[b] = 0;
+            for (int i = this->first[nb]; i < this->end[nb]; i++) {
+                this->block_of[this->elements[i]] = nb;
+            }
+            splits.push_back(std::make_pair(b, nb));
+        }
+        this->touched.clear();
+    }
+
+    // RefinablePartition Information
+    /**
+     * @brief Gets the number of blocks
+     * 
+     * @return The number of blocks
+     */
+    int getBlockCount() const {
+        return (int) this->first.size();
+    }
+
+    /**
+     * @brief Gets the number of elements of a block
+     * 
+     * @param b The block
+     * @return The size of the block
+     */
+    int getBlockSize(int b) const {
+        return this->end[b] - this->first[b];
+    }
+
+    /**
+     * @brief Gets the block of an element
+     * 
+     * @param e The element
+     * @return The block
+     */
+    int getBlock(int e) const {
+        return this->block_of[e];
+    }
+
+    /**
+     * @brief Gets the first element of a block. The elements of a block are contiguous until the next split
+     * 
+     * @param b The block
+     * @return A pointer to the first element
+     */
+    const int* getBlockBegin(int b) const {
+        return this->elements.data() + this->first[b];
+    }
+
+    /**
+     * @brief Gets the end of the elements of a block
+     * 
+     * @param b The block
+     * @return A pointer past the last element
+     */
+    const int* getBlockEnd(int b) const {
+        return this->elements.data() + this->end[b];
+    }
+
+    /**
+     * @brief Numbers the blocks in order of first appearance of their elements
+     * 
+     * @return The class of each element
+     */
+    std::vector<int> getClasses() const {
+        std::vector<int> number(this->first.size(), -1);
+        std::vector<int> classes(this->elements.size());
+        int count = 0;
+        for (int e = 0; e < (int) this->elements.size(); e++) {
+            if (number[this->block_of[e]] == -1) {
+                number[this->block_of[e]] = count++;
+            }
+            classes[e] = number[this->block_of[e]];
+        }
+        return classes;
+    }
+};
+
+/**
+ * @brief Computes the equivalence classes of the states of a DFA with Hopcroft's O(k n log n) partition refinement. The refinement starts from the blocks given by the labels, so states with different labels are never merged. Missing transitions go to an implicit dead state, which takes part in the refinement as the state of index n.
+ * 
+ * @param dfa The DFA
+ * @param labels One label per state
+ * @param dead_label The label of the implicit dead state
+ * @return The class of each state, numbered from 0 in order of first appearance. The last entry is the class of the dead state
+ */
+std::vector<int> computeEquivalenceClasses(const IndexedDFA& dfa, std::vector<int> labels, int dead_label) {
+    int n = dfa.getStateCount() + 1;
+    int k = dfa.getSymbolCount();
+    int dead = n - 1;
+    labels.push_back(dead_label);
+
+    // Inverse transitions: the states that reach t reading a are predecessors[predecessors_start[t*k+a] .. predecessors_start[t*k+a+1])
+    std::vector<int> next((size_t) n * k);
+    for (int s = 0; s < n; s++) {
+        for (int a = 0; a < k; a++) {
+            int t = s == dead ? NO_STATE : dfa.transite(s, a);
+            next[(size_t) s * k + a] = t == NO_STATE ? dead : t;
+        }
+    }
+    std::vector<size_t> predecessors_start((size_t) n * k + 1, 0);
+    for (size_t i = 0; i < next.size(); i++) {
+        predecessors_start[(size_t) next[i] * k + i % k + 1]++;
+    }
+    for (size_t i = 1; i < predecessors_start.size(); i++) {
+        predecessors_start[i] += predecessors_start[i - 1];
+    }
+    std::vector<int> predecessors(next.size());
+    std::vector<size_t> fill(predecessors_start.begin(), predecessors_start.end() - 1);
+    for (size_t i = 0; i < next.size(); i++) {
+        predecessors[fill[(size_t) next[i] * k + i % k]++] = (int) (i / k);
+    }
+
+    RefinablePartition partition = RefinablePartition(labels);
+
+    // Splitters (block, symbol). All blocks but the largest start in the worklist
+    std::vector<std::pair<int, int>> worklist;
+    std::vector<bool> in_worklist(partition.getBlockCount() * k, false);
+    int largest = 0;
+    for (int b = 1; b < partition.getBlockCount(); b++) {
+        if (partition.getBlockSize(b) > partition.getBlockSize(largest)) {
+            largest = b;
+        }
+    }
+    for (int b = 0; b < partition.getBlockCount(); b++) {
+        for (int a = 0; a < k && b != largest; a++) {
+            worklist.push_back(std::make_pair(b, a));
+            in_worklist[(size_t) b * k + a] = true;
+        }
+    }
+
+    std::vector<int> splitter;
+    std::vector<std::pair<int, int>> splits;
+    while (worklist.size() > 0) {
+        int B = worklist.back().first;
+        int a = worklist.back().second;
+        worklist.pop_back();
+        in_worklist[(size_t) B * k + a] = false;
+
+        // Marking the states that reach B reading a
+        splitter.assign(partition.getBlockBegin(B), partition.getBlockEnd(B));
+        for (int t : splitter) {
+            for (size_t i = predecessors_start[(size_t) t * k + a]; i < predecessors_start[(size_t) t * k + a + 1]; i++) {
+                partition.mark(predecessors[i]);
+            }
+        }
+
+        // Splitting every block that was only partly marked
+        partition.split(splits);
+        in_worklist.resize(partition.getBlockCount() * k, false);
+        for (std::pair<int, int> split : splits) {
+            int b = split.first;
+            int nb = split.second;
+            int smaller = partition.getBlockSize(nb) <= partition.getBlockSize(b) ? nb : b;
+            for (int c = 0; c < k; c++) {
+                int added = in_worklist[(size_t) b * k + c] ? nb : smaller;
+                if (!in_worklist[(size_t) added * k + c]) {
+                    worklist.push_back(std::make_pair(added, c));
+                    in_worklist[(size_t) added * k + c] = true;
+                }
+            }
+        }
+    }
+
+    return partition.getClasses();
+}
+
+/**
+ * @brief Merges the states of each equivalence class of a DFA. Each class becomes one state named after its first member, numbered in order of first appearance, and the class of the dead state is dropped
+ * 
+ * @param dfa The DFA, with only reachable states
+ * @param classes The class of each state, followed by the class of the dead state
+ * @return The quotient DFA
+ */
+IndexedDFA buildIndexedQuotient(const IndexedDFA& dfa, const std::vector<int>& classes) {
+    int dead = classes.back();
+    std::vector<int> number(classes.size(), NO_STATE);
+    std::vector<int> first_member;
+    IndexedDFA minimal = IndexedDFA(dfa.getSymbols());
+    for (int s = 0; s < dfa.getStateCount(); s++) {
+        if (classes[s] != dead && number[classes[s]] == NO_STATE) {
+            number[classes[s]] = minimal.addState(dfa.getStateName(s), dfa.isFinalState(s));
+            minimal.setStateLabel(number[classes[s]], dfa.getStateLabel(s));
+            first_member.push_back(s);
+        }
+    }
+    for (int c = 0; c < minimal.getStateCount(); c++) {
+        for (int a = 0; a < dfa.getSymbolCount(); a++) {
+            int t = dfa.transite(first_member[c], a);
+            minimal.setTransition(c, a, t == NO_STATE ? NO_STATE : number[classes[t]]);
+        }
+    }
+    if (dfa.getInitialState() != NO_STATE) {
+        int initial = number[classes[dfa.getInitialState()]];
+        if (initial == NO_STATE) {
+            initial = minimal.addState(dfa.getStateName(dfa.getInitialState()), false);
+        }
+        minimal.setInitialState(initial);
+    }
+    return minimal;
+}
+
+/**
+ * @brief Merges the states of each equivalence class of a DFA like buildIndexedQuotient, but names each state after all the members of its class, sorted and joined with commas, as SuperDFA::convertToDfa does
+ * 
+ * @param dfa The DFA, with only reachable states
+ * @param classes The class of each state, followed by the class of the dead state
+ * @return The quotient DFA
+ */
+IndexedDFA buildNamedQuotient(const IndexedDFA& dfa, const std::vector<int>& classes) {
+    IndexedDFA quotient = buildIndexedQuotient(dfa, classes);
+    int dead = classes.back();
+    std::vector<std::set<state>> members(classes.size());
+    std::vector<int> class_of;
+    for (int s = 0; s < dfa.getStateCount(); s++) {
+        if (classes[s] != dead && members[classes[s]].size() == 0) {
+            class_of.push_back(classes[s]);
+        }
+        members[classes[s]].insert(dfa.getStateName(s));
+    }
+    if ((int) class_of.size() < quotient.getStateCount()) {
+        class_of.push_back(dead);
+    }
+
+    IndexedDFA named = IndexedDFA(dfa.getSymbols());
+    for (int c = 0; c < quotient.getStateCount(); c++) {
+        std::string name = "";
+        for (state s : members[class_of[c]]) {
+            name += (s + ",");
+        }
+        name.pop_back();
+        named.addState(name, quotient.isFinalState(c));
+        named.setStateLabel(c, quotient.getStateLabel(c));
+    }
+    for (int c = 0; c < quotient.getStateCount(); c++) {
+        for (int a = 0; a < quotient.getSymbolCount(); a++) {
+            named.setTransition(c, a, quotient.transite(c, a));
+        }
+    }
+    if (quotient.getInitialState() != NO_STATE) {
+        named.setInitialState(quotient.getInitialState());
+    }
+    return named;
+}
+
+/**
+ * @brief Minimizes a DFA with Hopcroft's partition refinement, without going through the DFA class
+ * 
+ * @param dfa The DFA, with only reachable states
+ * @return The minimal DFA, its states named after the first member of their class
+ */
+IndexedDFA minimizeIndexedDfa(const IndexedDFA& dfa) {
+    return buildIndexedQuotient(dfa, computeEquivalenceClasses(dfa, getAcceptanceLabels(dfa), 0));
+}
\ No newline at end of file
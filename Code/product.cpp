@@ -0,0 +1,147 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include "equivalence.cpp"
+#include "partition.cpp"
+
+/**
+ * @brief The boolean operations that can be done with the product construction
+ */
+enum productOperation {
+    INTERSECTION,
+    UNION,
+    DIFFERENCE,
+    SYMMETRIC_DIFFERENCE
+};
+
+/**
+ * @brief Checks if a pair of states is accepting under an operation
+ * 
+ * @param operation The boolean operation
+ * @param final1 Whether the state of the first DFA is final
+ * @param final2 Whether the state of the second DFA is final
+ * @return true if the pair is accepting. false otherwise
+ */
+bool productAccepts(productOperation operation, bool final1, bool final2) {
+    switch (operation) {
+    case INTERSECTION:
+        return final1 && final2;
+    case UNION:
+        return final1 || final2;
+    case DIFFERENCE:
+        return final1 && !final2;
+    default:
+        return final1 != final2;
+    }
+}
+
+/**
+ * @brief Checks if a pair of states can never accept under an operation, so it does not need to be built
+ * 
+ * @param operation The boolean operation
+ * @param dead1 Whether the state of the first DFA is dead
+ * @param dead2 Whether the state of the second DFA is dead
+ * @return true if the pair is dead. false otherwise
+ */
+bool productIsDead(productOperation operation, bool dead1, bool dead2) {
+    switch (operation) {
+    case INTERSECTION:
+        return dead1 || dead2;
+    case DIFFERENCE:
+        return dead1;
+    default:
+        return dead1 && dead2;
+    }
+}
+
+/**
+ * @brief Builds the product of two DFAs for a boolean operation. Only the pairs of states reachable from the pair of initial states are explored, through a worklist and a pair to id hash table, and pairs that can never accept are left out as missing transitions. The states of the result are named by their BFS order.
+ * 
+ * @param dfa1 The first DFA
+ * @param dfa2 The second DFA
+ * @param operation The boolean operation
+ * @param minimize If true, the equivalence classes of each DFA are computed first and every pair is built from class representatives, which prunes the states equivalent to the dead state and keeps the product small while it is built, and the product is then minimized with Hopcroft's algorithm, since pairs of representatives may still be equivalent
+ * @return The DFA of the operation, over the union of the alphabets. It is minimal when minimize is set
+ */
+DFA buildProduct(DFA dfa1, DFA dfa2, productOperation operation, bool minimize) {
+    PairedDFA paired = PairedDFA(dfa1, dfa2);
+    int k = (int) paired.getSymbols().size();
+    unsigned long long total = (unsigned long long) paired.getStateCount();
+
+    // representative[i][s]: the state used for the local state s of DFA i (s = n_i is the dead state)
+    std::vector<int> representative[2];
+    std::vector<bool> dead[2];
+    for (int i = 0; i < 2; i++) {
+        const IndexedDFA& side = paired.getDfa(i);
+        int n = side.getStateCount();
+        representative[i] = std::vector<int>(n + 1);
+        dead[i] = std::vector<bool>(n + 1, false);
+        std::iota(representative[i].begin(), representative[i].end(), paired.getOffset(i));
+        dead[i][n] = true;
+        if (minimize) {
+            std::vector<int> classes = computeEquivalenceClasses(side, getAcceptanceLabels(side), 0);
+            std::vector<int> first_of_class(n + 1, -1);
+            for (int s = 0; s <= n; s++) {
+                if (first_of_class[classes[s]] == -1) {
+                    first_of_class[classes[s]] = s;
+                }
+                representative[i][s] = paired.getOffset(i) + first_of_class[classes[s]];
+                dead[i][s] = classes[s] == classes[n];
+            }
+        }
+    }
+    auto canonical = [&](int i, int s) { return representative[i][s - paired.getOffset(i)]; };
+    auto isDead = [&](int i, int s) { return dead[i][s - paired.getOffset(i)]; };
+
+    IndexedDFA result = IndexedDFA(paired.getSymbols());
+    std::unordered_map<unsigned long long, int> ids;
+    std::vector<std::pair<int, int>> pairs;
+    auto intern = [&](int p, int q) {
+        auto it = ids.find(p * total + q);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        int id = result.addState(std::to_string(pairs.size()), productAccepts(operation, paired.isFinalState(p), paired.isFinalState(q)));
+        ids[p * total + q] = id;
+        pairs.push_back(std::make_pair(p, q));
+        return id;
+    };
+
+    result.setInitialState(intern(canonical(0, paired.getInitialState(0)), canonical(1, paired.getInitialState(1))));
+    for (size_t head = 0; head < pairs.size(); head++) {
+        int p = pairs[head].first;
+        int q = pairs[head].second;
+        if (productIsDead(operation, isDead(0, p), isDead(1, q))) {
+            continue;
+        }
+        for (int a = 0; a < k; a++) {
+            int p2 = canonical(0, paired.transite(p, a));
+            int q2 = canonical(1, paired.transite(q, a));
+            if (!productIsDead(operation, isDead(0, p2), isDead(1, q2))) {
+                result.setTransition((int) head, a, intern(p2, q2));
+            }
+        }
+    }
+
+    if (minimize) {
+        result = minimizeIndexedDfa(result);
+    }
+    return result.convertToDfa();
+}
+
+/**
+ * @brief Builds the complement of a DFA over its own alphabet. The unreachable states are removed, the virtual dead state is turned into a real error state only if some transition is missing, since it becomes accepting, and the final states are flipped
+ * 
+ * @param dfa The DFA
+ * @return The DFA accepting every word over the alphabet that the DFA rejects
+ */
+DFA complementDfa(DFA dfa) {
+    dfa.removeUnreachableStates();
+    dfa.completeAutomaton();
+    return DFA(dfa.getStates(), dfa.getAlphabet(), dfa.getTransitions(), dfa.getInitialState(), dfa.getNonFinalStates());
+}
\ No newline at end of file
@@ -0,0 +1,424 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <bitset>
+#include <cctype>
+#include <stdexcept>
+#include "subset.cpp"
+#include "partition.cpp"
+
+/**
+ * @brief The kinds of nodes of a parsed regular expression
+ */
+enum regexNodeType {
+    REGEX_EMPTY,
+    REGEX_CLASS,
+    REGEX_CONCAT,
+    REGEX_UNION,
+    REGEX_STAR,
+    REGEX_PLUS,
+    REGEX_OPTIONAL
+};
+
+/**
+ * @brief A node of a parsed regular expression. A class node is one position of the Glushkov automaton and matches any byte of its set
+ */
+struct regexNode {
+    regexNodeType type;
+    int left;
+    int right;
+    std::bitset<256> bytes;
+};
+
+/**
+ * @brief A recursive descent parser of regular expressions over bytes. It knows alternation (|), concatenation, the postfix operators *, + and ?, groups, the wildcard . (any byte but the line break), character classes such as [a-z_] or [^0-9], whose complement is taken over all 256 bytes, and the escapes \d, \w, \s, \n, \t and \ followed by any other character. An empty alternative matches the empty word
+ */
+class RegexParser {
+private:
+    std::string pattern;
+    size_t position;
+    std::vector<regexNode> nodes;
+
+    /**
+     * @brief Adds a node
+     * 
+     * @param type The kind of node
+     * @param left The first child, or -1
+     * @param right The second child, or -1
+     * @return The index of the node
+     */
+    int addNode(regexNodeType type, int left, int right) {
+        regexNode node;
+        node.type = type;
+        node.left = left;
+        node.right = right;
+        this->nodes.push_back(node);
+        return (int) this->nodes.size() - 1;
+    }
+
+    /**
+     * @brief Builds the error of an unexpected character or end of pattern
+     * 
+     * @param message What went wrong
+     * @return The exception
+     */
+    std::invalid_argument error(std::string message) {
+        return std::invalid_argument(message + " at position " + std::to_string(this->position) + " of the regular expression.");
+    }
+
+    /**
+     * @brief Gets the bytes of the wildcard
+     * 
+     * @return Every byte but the line break
+     */
+    static std::bitset<256> wildcard() {
+        std::bitset<256> bytes;
+        bytes.set();
+        bytes.reset('\n');
+        return bytes;
+    }
+
+    /**
+     * @brief Gets the smallest byte of a set
+     * 
+     * @param bytes The set, with at least one byte
+     * @return The byte
+     */
+    static char firstByte(const std::bitset<256>& bytes) {
+        int b = 0;
+        while (!bytes.test(b)) {
+            b++;
+        }
+        return (char) b;
+    }
+
+    /**
+     * @brief Reads an escape, the backslash already consumed
+     * 
+     * @return The bytes the escape matches
+     */
+    std::bitset<256> parseEscape() {
+        if (this->position >= this->pattern.size()) {
+            throw this->error("Unfinished escape");
+        }
+        char c = this->pattern[this->position++];
+        std::bitset<256> bytes;
+        switch (c) {
+        case 'd':
+            for (int b = '0'; b <= '9'; b++) {
+                bytes.set(b);
+            }
+            break;
+        case 'w':
+            for (int b = 0; b < 256; b++) {
+                bytes[b] = std::isalnum(b) || b == '_';
+            }
+            break;
+        case 's':
+            for (char b : std::string(" \t\n\r\f\v")) {
+                bytes.set((unsigned char) b);
+            }
+            break;
+        case 'n':
+            bytes.set('\n');
+            break;
+        case 't':
+            bytes.set('\t');
+            break;
+        default:
+            bytes.set((unsigned char) c);
+            break;
+        }
+        return bytes;
+    }
+
+    /**
+     * @brief Reads a character class, the opening bracket already consumed
+     * 
+     * @return The bytes the class matches
+     */
+    std::bitset<256> parseClass() {
+        bool negated = this->position < this->pattern.size() && this->pattern[this->position] == '^';
+        if (negated) {
+            this->position++;
+        }
+        std::bitset<256> bytes;
+        bool first = true;
+        while (true) {
+            if (this->position >= this->pattern.size()) {
+                throw this->error("Unclosed character class");
+            }
+            char c = this->pattern[this->position];
+            if (c == ']' && !first) {
+                this->position++;
+                break;
+            }
+            first = false;
+            this->position++;
+            if (c == '\\') {
+                std::bitset<256> escaped = this->parseEscape();
+                if (escaped.count() != 1) {
+                    bytes |= escaped;
+                    continue;
+                }
+                c = firstByte(escaped);
+            }
+            int low = (unsigned char) c;
+            int high = low;
+            if (this->position + 1 < this->pattern.size() && this->pattern[this->position] == '-' && this->pattern[this->position + 1] != ']') {
+                this->position++;
+                char end = this->pattern[this->position++];
+                if (end == '\\') {
+                    std::bitset<256> escaped = this->parseEscape();
+                    if (escaped.count() != 1) {
+                        throw this->error("Invalid range end");
+                    }
+                    end = firstByte(escaped);
+                }
+                high = (unsigned char) end;
+                if (high < low) {
+                    throw this->error("Reversed range");
+                }
+            }
+            for (int b = low; b <= high; b++) {
+                bytes.set(b);
+            }
+        }
+        return negated ? ~bytes : bytes;
+    }
+
+    /**
+     * @brief Reads a group, a class, a wildcard, an escape or a character
+     * 
+     * @return The index of the node
+     */
+    int parseAtom() {
+        char c = this->pattern[this->position++];
+        if (c == '(') {
+            int node = this->parseUnion();
+            if (this->position >= this->pattern.size() || this->pattern[this->position] != ')') {
+                throw this->error("Missing ')'");
+            }
+            this->position++;
+            return node;
+        }
+        int node = this->addNode(REGEX_CLASS, -1, -1);
+        if (c == '[') {
+            this->nodes[node].bytes = this->parseClass();
+        } else if (c == '.') {
+            this->nodes[node].bytes = wildcard();
+        } else if (c == '\\') {
+            this->nodes[node].bytes = this->parseEscape();
+        } else if (c == '*' || c == '+' || c == '?' || c == ')' || c == ']') {
+            this->position--;
+            throw this->error(std::string("Unexpected '") + c + "'");
+        } else {
+            this->nodes[node].bytes.set((unsigned char) c);
+        }
+        if (this->nodes[node].bytes.none()) {
+            throw this->error("Empty character class");
+        }
+        return node;
+    }
+
+    /**
+     * @brief Reads an atom followed by any number of postfix operators
+     * 
+     * @return The index of the node
+     */
+    int parseRepetition() {
+        int node = this->parseAtom();
+        while (this->position < this->pattern.size()) {
+            char c = this->pattern[this->position];
+            regexNodeType type = c == '*' ? REGEX_STAR : c == '+' ? REGEX_PLUS : c == '?' ? REGEX_OPTIONAL : REGEX_EMPTY;
+            if (type == REGEX_EMPTY) {
+                break;
+            }
+            this->position++;
+            node = this->addNode(type, node, -1);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Reads a sequence of repetitions, which may be empty
+     * 
+     * @return The index of the node
+     */
+    int parseConcatenation() {
+        int node = -1;
+        while (this->position < this->pattern.size() && this->pattern[this->position] != '|' && this->pattern[this->position] != ')') {
+            int next = this->parseRepetition();
+            node = node == -1 ? next : this->addNode(REGEX_CONCAT, node, next);
+        }
+        return node == -1 ? this->addNode(REGEX_EMPTY, -1, -1) : node;
+    }
+
+    /**
+     * @brief Reads alternatives separated by |
+     * 
+     * @return The index of the node
+     */
+    int parseUnion() {
+        int node = this->parseConcatenation();
+        while (this->position < this->pattern.size() && this->pattern[this->position] == '|') {
+            this->position++;
+            node = this->addNode(REGEX_UNION, node, this->parseConcatenation());
+        }
+        return node;
+    }
+
+public:
+    // Constructors
+    RegexParser(std::string pattern) {
+        this->pattern = pattern;
+        this->position = 0;
+        this->nodes = std::vector<regexNode>();
+    }
+
+    // RegexParser Operations
+    /**
+     * @brief Parses the whole pattern
+     * 
+     * @return The index of the root node
+     */
+    int parse() {
+        this->nodes.clear();
+        this->position = 0;
+        int root = this->parseUnion();
+        if (this->position < this->pattern.size()) {
+            throw this->error("Unexpected ')'");
+        }
+        return root;
+    }
+
+    // RegexParser Information
+    /**
+     * @brief Gets the parsed nodes. A child always comes before its parent
+     * 
+     * @return The nodes
+     */
+    const std::vector<regexNode>& getNodes() const {
+        return this->nodes;
+    }
+};
+
+/**
+ * @brief Builds the Glushkov (position) automaton of a regular expression: one initial state plus one state per character class of the pattern, with no ε-transitions. The transitions into a position read the bytes of its class, and they leave the initial state towards the first positions and each position towards the positions that may follow it
+ * 
+ * @param pattern The regular expression
+ * @return The NFA, over the bytes that appear in the pattern
+ */
+NFA buildGlushkovNfa(std::string pattern) {
+    RegexParser parser = RegexParser(pattern);
+    int root = parser.parse();
+    const std::vector<regexNode>& nodes = parser.getNodes();
+
+    // Positions, then nullable, first and last of every node, children before parents
+    std::vector<int> position_of(nodes.size(), -1);
+    std::vector<int> nodes_of_positions;
+    std::bitset<256> used;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i].type == REGEX_CLASS) {
+            position_of[i] = (int) nodes_of_positions.size() + 1;
+            nodes_of_positions.push_back((int) i);
+            used |= nodes[i].bytes;
+        }
+    }
+    int n = (int) nodes_of_positions.size() + 1;
+    std::vector<bool> nullable(nodes.size());
+    std::vector<std::vector<int>> first(nodes.size()), last(nodes.size());
+    std::vector<std::vector<int>> follow(n);
+    for (size_t i = 0; i < nodes.size(); i++) {
+        const regexNode& node = nodes[i];
+        int l = node.left;
+        int r = node.right;
+        switch (node.type) {
+        case REGEX_EMPTY:
+            nullable[i] = true;
+            break;
+        case REGEX_CLASS:
+            nullable[i] = false;
+            first[i].push_back(position_of[i]);
+            last[i].push_back(position_of[i]);
+            break;
+        case REGEX_UNION:
+            nullable[i] = nullable[l] || nullable[r];
+            first[i] = first[l];
+            first[i].insert(first[i].end(), first[r].begin(), first[r].end());
+            last[i] = last[l];
+            last[i].insert(last[i].end(), last[r].begin(), last[r].end());
+            break;
+        case REGEX_CONCAT:
+            nullable[i] = nullable[l] && nullable[r];
+            first[i] = first[l];
+            if (nullable[l]) {
+                first[i].insert(first[i].end(), first[r].begin(), first[r].end());
+            }
+            last[i] = last[r];
+            if (nullable[r]) {
+                last[i].insert(last[i].end(), last[l].begin(), last[l].end());
+            }
+            for (int p : last[l]) {
+                follow[p].insert(follow[p].end(), first[r].begin(), first[r].end());
+            }
+            break;
+        default:
+            nullable[i] = node.type != REGEX_PLUS ? true : nullable[l];
+            first[i] = first[l];
+            last[i] = last[l];
+            if (node.type != REGEX_OPTIONAL) {
+                for (int p : last[l]) {
+                    follow[p].insert(follow[p].end(), first[l].begin(), first[l].end());
+                }
+            }
+            break;
+        }
+    }
+    follow[0] = first[root];
+
+    // The alphabet is made of the bytes that appear in some class
+    std::vector<std::string> symbols;
+    std::vector<int> symbol_of(256, -1);
+    for (int b = 0; b < 256; b++) {
+        if (used[b]) {
+            symbol_of[b] = (int) symbols.size();
+            symbols.push_back(std::string(1, (char) b));
+        }
+    }
+    NFA nfa = NFA(symbols);
+    std::vector<bool> final_positions(n, false);
+    for (int p : last[root]) {
+        final_positions[p] = true;
+    }
+    final_positions[0] = nullable[root];
+    for (int p = 0; p < n; p++) {
+        nfa.addState(std::to_string(p), final_positions[p]);
+    }
+    nfa.addInitialState(0);
+    for (int p = 0; p < n; p++) {
+        for (int q : follow[p]) {
+            const std::bitset<256>& bytes = nodes[nodes_of_positions[q - 1]].bytes;
+            for (int b = 0; b < 256; b++) {
+                if (bytes[b]) {
+                    nfa.addTransition(p, symbol_of[b], q);
+                }
+            }
+        }
+    }
+    return nfa;
+}
+
+/**
+ * @brief Compiles a regular expression into its minimal DFA: Glushkov automaton, subset construction and Hopcroft's minimization, all in memory
+ * 
+ * @param pattern The regular expression
+ * @return The minimal DFA, over the bytes that appear in the pattern
+ */
+DFA compileRegex(std::string pattern) {
+    return minimizeIndexedDfa(determinize(buildGlushkovNfa(pattern), SUBSET_MAX_STATES)).convertToDfa();
+}
\ No newline at end of file
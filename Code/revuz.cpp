@@ -0,0 +1,225 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "partition.cpp"
+
+// The height of a state from which no final state can be reached
+#define NO_HEIGHT -1
+
+/**
+ * @brief Finds the states of a DFA from which a final or a labelled state can be reached
+ * 
+ * @param dfa The DFA
+ * @return Whether each state is useful
+ */
+std::vector<bool> findUsefulStates(const IndexedDFA& dfa) {
+    int n = dfa.getStateCount();
+    int k = dfa.getSymbolCount();
+    std::vector<int> predecessors_start(n + 1, 0);
+    for (int s = 0; s < n; s++) {
+        for (int a = 0; a < k; a++) {
+            if (dfa.transite(s, a) != NO_STATE) {
+                predecessors_start[dfa.transite(s, a) + 1]++;
+            }
+        }
+    }
+    for (int s = 0; s < n; s++) {
+        predecessors_start[s + 1] += predecessors_start[s];
+    }
+    std::vector<int> predecessors(predecessors_start[n]);
+    std::vector<int> fill(predecessors_start.begin(), predecessors_start.end() - 1);
+    for (int s = 0; s < n; s++) {
+        for (int a = 0; a < k; a++) {
+            if (dfa.transite(s, a) != NO_STATE) {
+                predecessors[fill[dfa.transite(s, a)]++] = s;
+            }
+        }
+    }
+
+    std::vector<bool> useful(n, false);
+    std::vector<int> stack;
+    for (int s = 0; s < n; s++) {
+        if (dfa.isFinalState(s) || dfa.getStateLabel(s) != "") {
+            useful[s] = true;
+            stack.push_back(s);
+        }
+    }
+    while (stack.size() > 0) {
+        int t = stack.back();
+        stack.pop_back();
+        for (int i = predecessors_start[t]; i < predecessors_start[t + 1]; i++) {
+            if (!useful[predecessors[i]]) {
+                useful[predecessors[i]] = true;
+                stack.push_back(predecessors[i]);
+            }
+        }
+    }
+    return useful;
+}
+
+/**
+ * @brief Computes the height of every state of a DFA, the length of the longest path from it to a state without useful transitions, with an iterative topological pass that peels those states off first. The states that cannot reach a final or a labelled state are left out, since they all behave like the dead state
+ * 
+ * @param dfa The DFA
+ * @return The height of each state, NO_HEIGHT for the useless ones, or an empty vector when the useful states have a cycle
+ */
+std::vector<int> computeStateHeights(const IndexedDFA& dfa) {
+    int n = dfa.getStateCount();
+    int k = dfa.getSymbolCount();
+    std::vector<bool> useful = findUsefulStates(dfa);
+
+    // Useful transitions reversed, and how many of them leave each state
+    std::vector<int> remaining(n, 0);
+    std::vector<int> predecessors_start(n + 1, 0);
+    for (int s = 0; s < n; s++) {
+        for (int a = 0; a < k && useful[s]; a++) {
+            int t = dfa.transite(s, a);
+            if (t != NO_STATE && useful[t]) {
+                remaining[s]++;
+                predecessors_start[t + 1]++;
+            }
+        }
+    }
+    for (int s = 0; s < n; s++) {
+        predecessors_start[s + 1] += predecessors_start[s];
+    }
+    std::vector<int> predecessors(predecessors_start[n]);
+    std::vector<int> fill(predecessors_start.begin(), predecessors_start.end() - 1);
+    for (int s = 0; s < n; s++) {
+        for (int a = 0; a < k && useful[s]; a++) {
+            int t = dfa.transite(s, a);
+            if (t != NO_STATE && useful[t]) {
+                predecessors[fill[t]++] = s;
+            }
+        }
+    }
+
+    std::vector<int> heights(n, NO_HEIGHT);
+    std::vector<int> ready;
+    int useful_count = 0;
+    for (int s = 0; s < n; s++) {
+        if (useful[s]) {
+            useful_count++;
+            if (remaining[s] == 0) {
+                heights[s] = 0;
+                ready.push_back(s);
+            }
+        }
+    }
+    int peeled = 0;
+    while (ready.size() > 0) {
+        int t = ready.back();
+        ready.pop_back();
+        peeled++;
+        for (int i = predecessors_start[t]; i < predecessors_start[t + 1]; i++) {
+            int s = predecessors[i];
+            heights[s] = std::max(heights[s], heights[t] + 1);
+            if (--remaining[s] == 0) {
+                ready.push_back(s);
+            }
+        }
+    }
+    if (peeled < useful_count) {
+        return std::vector<int>();
+    }
+    return heights;
+}
+
+/**
+ * @brief Computes the equivalence classes of the states of an acyclic DFA with Revuz's algorithm, in O(k n) expected time. Equivalent states have the same height, so the states are bucketed by height and, from height 0 upwards, the states of a bucket with the same finality, the same label and the same classes of successors are merged, the classes of the successors being already known. The useless states go to the class of the dead state
+ * 
+ * @param dfa The DFA
+ * @param heights The heights given by computeStateHeights
+ * @return The class of each state, numbered from 0 in order of first appearance. The last entry is the class of the dead state
+ */
+std::vector<int> computeAcyclicEquivalenceClasses(const IndexedDFA& dfa, const std::vector<int>& heights) {
+    int n = dfa.getStateCount();
+    int k = dfa.getSymbolCount();
+
+    // Buckets of states by height, with a counting sort
+    int max_height = -1;
+    for (int s = 0; s < n; s++) {
+        max_height = std::max(max_height, heights[s]);
+    }
+    std::vector<int> bucket_start(max_height + 2, 0);
+    for (int s = 0; s < n; s++) {
+        if (heights[s] != NO_HEIGHT) {
+            bucket_start[heights[s] + 1]++;
+        }
+    }
+    for (int h = 0; h <= max_height; h++) {
+        bucket_start[h + 1] += bucket_start[h];
+    }
+    std::vector<int> buckets(bucket_start[max_height + 1]);
+    std::vector<int> fill(bucket_start.begin(), bucket_start.end() - 1);
+    for (int s = 0; s < n; s++) {
+        if (heights[s] != NO_HEIGHT) {
+            buckets[fill[heights[s]]++] = s;
+        }
+    }
+
+    // The signature of a state is its finality and label and the classes of its successors, the useless ones being NO_STATE
+    std::vector<int> acceptance = getAcceptanceLabels(dfa);
+    std::vector<int> classes(n, NO_STATE);
+    std::vector<int> signatures((size_t) n * (k + 1));
+    auto getSignature = [&](int s) {
+        return signatures.data() + (size_t) s * (k + 1);
+    };
+    std::unordered_multimap<unsigned long long, int> representatives;
+    int class_count = 0;
+    for (int h = 0; h <= max_height; h++) {
+        representatives.clear();
+        for (int i = bucket_start[h]; i < bucket_start[h + 1]; i++) {
+            int s = buckets[i];
+            int* signature = getSignature(s);
+            signature[0] = acceptance[s];
+            unsigned long long hash = 14695981039346656037ULL ^ signature[0];
+            for (int a = 0; a < k; a++) {
+                int t = dfa.transite(s, a);
+                signature[a + 1] = t == NO_STATE || heights[t] == NO_HEIGHT ? NO_STATE : classes[t];
+                hash = (hash ^ (unsigned) signature[a + 1]) * 1099511628211ULL;
+            }
+            auto range = representatives.equal_range(hash);
+            for (auto it = range.first; it != range.second; it++) {
+                if (std::equal(signature, signature + k + 1, getSignature(it->second))) {
+                    classes[s] = classes[it->second];
+                    break;
+                }
+            }
+            if (classes[s] == NO_STATE) {
+                classes[s] = class_count++;
+                representatives.emplace(hash, s);
+            }
+        }
+    }
+
+    // Renumbering in order of first appearance, the dead state last
+    std::vector<int> number(class_count + 1, NO_STATE);
+    std::vector<int> renumbered(n + 1);
+    int next_number = 0;
+    for (int s = 0; s <= n; s++) {
+        int c = s < n && classes[s] != NO_STATE ? classes[s] : class_count;
+        if (number[c] == NO_STATE) {
+            number[c] = next_number++;
+        }
+        renumbered[s] = number[c];
+    }
+    return renumbered;
+}
+
+/**
+ * @brief Minimizes an acyclic DFA with Revuz's algorithm, in linear time instead of the rounds of a partition refinement
+ * 
+ * @param dfa The DFA, with only reachable states
+ * @param heights The heights given by computeStateHeights, which must not be empty
+ * @return The minimal DFA, its states named after the first member of their class
+ */
+IndexedDFA minimizeAcyclicDfa(const IndexedDFA& dfa, const std::vector<int>& heights) {
+    return buildIndexedQuotient(dfa, computeAcyclicEquivalenceClasses(dfa, heights));
+}
\ No newline at end of file
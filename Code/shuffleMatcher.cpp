@@ -0,0 +1,278 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <memory>
+#include "matcher.cpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SHUFFLE_X86
+#include <immintrin.h>
+#endif
+
+// Largest number of states (dead state included) that fits in one shuffle register
+#define SHUFFLE_MAX_STATES 16
+
+#ifdef SHUFFLE_X86
+/**
+ * @brief Advances the 16 lanes of states through some bytes, one pshufb per byte
+ * 
+ * @param shuffles The 256 rows of 16 next states, one row per byte
+ * @param data The bytes
+ * @param length The number of bytes
+ * @param states The 16 states, updated in place
+ */
+__attribute__((target("ssse3")))
+inline void shuffleRun(const unsigned char* shuffles, const unsigned char* data, size_t length, unsigned char* states) {
+    const __m128i* rows = (const __m128i*) shuffles;
+    __m128i s = _mm_loadu_si128((const __m128i*) states);
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4) {
+        s = _mm_shuffle_epi8(_mm_load_si128(rows + data[i]), s);
+        s = _mm_shuffle_epi8(_mm_load_si128(rows + data[i + 1]), s);
+        s = _mm_shuffle_epi8(_mm_load_si128(rows + data[i + 2]), s);
+        s = _mm_shuffle_epi8(_mm_load_si128(rows + data[i + 3]), s);
+    }
+    for (; i < length; i++) {
+        s = _mm_shuffle_epi8(_mm_load_si128(rows + data[i]), s);
+    }
+    _mm_storeu_si128((__m128i*) states, s);
+}
+
+/**
+ * @brief Advances four independent words together, so their shuffle chains overlap
+ * 
+ * @param shuffles The 256 rows of 16 next states, one row per byte
+ * @param data The bytes of each word
+ * @param length The number of bytes walked in every word
+ * @param states The 16 states of each word, updated in place
+ */
+__attribute__((target("ssse3")))
+inline void shuffleRun4(const unsigned char* shuffles, const unsigned char* data[4], size_t length, unsigned char states[4][16]) {
+    const __m128i* rows = (const __m128i*) shuffles;
+    __m128i s0 = _mm_loadu_si128((const __m128i*) states[0]);
+    __m128i s1 = _mm_loadu_si128((const __m128i*) states[1]);
+    __m128i s2 = _mm_loadu_si128((const __m128i*) states[2]);
+    __m128i s3 = _mm_loadu_si128((const __m128i*) states[3]);
+    for (size_t i = 0; i < length; i++) {
+        s0 = _mm_shuffle_epi8(_mm_load_si128(rows + data[0][i]), s0);
+        s1 = _mm_shuffle_epi8(_mm_load_si128(rows + data[1][i]), s1);
+        s2 = _mm_shuffle_epi8(_mm_load_si128(rows + data[2][i]), s2);
+        s3 = _mm_shuffle_epi8(_mm_load_si128(rows + data[3][i]), s3);
+    }
+    _mm_storeu_si128((__m128i*) states[0], s0);
+    _mm_storeu_si128((__m128i*) states[1], s1);
+    _mm_storeu_si128((__m128i*) states[2], s2);
+    _mm_storeu_si128((__m128i*) states[3], s3);
+}
+#endif
+
+/**
+ * @brief Checks if the processor can run the shuffle backend
+ * 
+ * @return true if SSSE3 is available. false otherwise
+ */
+inline bool isShuffleSupported() {
+#ifdef SHUFFLE_X86
+    return __builtin_cpu_supports("ssse3");
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief A matcher for DFAs with at most 16 states. Each byte has a row of 16 next states, and a vector holding the current state of 16 runs (one per start state) is advanced with a single pshufb per byte. The state reached from any start state is known at the end, which also gives the state mapping the parallel matcher needs.
+ */
+class ShuffleMatcher {
+private:
+    alignas(16) unsigned char shuffles[256 * SHUFFLE_MAX_STATES];
+    bool accepting[SHUFFLE_MAX_STATES];
+    unsigned char initial_state;
+
+    /**
+     * @brief Advances the 16 runs through some bytes, with pshufb when available
+     * 
+     * @param data The bytes
+     * @param length The number of bytes
+     * @param states The 16 states, updated in place
+     */
+    void run(const unsigned char* data, size_t length, unsigned char* states) const {
+#ifdef SHUFFLE_X86
+        if (isShuffleSupported()) {
+            shuffleRun(this->shuffles, data, length, states);
+            return;
+        }
+#endif
+        for (size_t i = 0; i < length; i++) {
+            const unsigned char* row = this->shuffles + data[i] * SHUFFLE_MAX_STATES;
+            for (int s = 0; s < SHUFFLE_MAX_STATES; s++) {
+                states[s] = row[states[s]];
+            }
+        }
+    }
+
+public:
+    // Constructors
+    /**
+     * @brief Builds the shuffle rows of a compiled DFA
+     * 
+     * @param matcher The compiled DFA. It must have at most SHUFFLE_MAX_STATES states
+     */
+    ShuffleMatcher(const TableMatcher& matcher) {
+        if (matcher.getStateCount() > SHUFFLE_MAX_STATES) {
+            throw std::invalid_argument("The DFA has more than " + std::to_string(SHUFFLE_MAX_STATES) + " states.");
+        }
+        int class_count = matcher.getClassCount();
+        std::memset(this->shuffles, 0, sizeof(this->shuffles));
+        for (int b = 0; b < 256; b++) {
+            for (int s = 0; s < matcher.getStateCount(); s++) {
+                int next = matcher.getTable()[s * class_count + matcher.getByteClasses()[b]];
+                this->shuffles[b * SHUFFLE_MAX_STATES + s] = (unsigned char) (next / class_count);
+            }
+        }
+        for (int s = 0; s < SHUFFLE_MAX_STATES; s++) {
+            this->accepting[s] = s < matcher.getStateCount() && matcher.isAcceptingRow(s * class_count);
+        }
+        this->initial_state = (unsigned char) (matcher.getInitialRow() / class_count);
+    }
+
+    // Matching
+    /**
+     * @brief Computes the state reached from every state through some bytes
+     * 
+     * @param data The bytes
+     * @param length The number of bytes
+     * @param states Receives the 16 reached states, indexed by start state
+     */
+    void mapAll(const char* data, size_t length, unsigned char* states) const {
+        for (int s = 0; s < SHUFFLE_MAX_STATES; s++) {
+            states[s] = (unsigned char) s;
+        }
+        this->run((const unsigned char*) data, length, states);
+    }
+
+    /**
+     * @brief Checks if the DFA accepts a word
+     * 
+     * @param data The bytes of the word
+     * @param length The number of bytes
+     * @return true if the word is accepted. false otherwise
+     */
+    bool matches(const char* data, size_t length) const {
+        alignas(16) unsigned char states[SHUFFLE_MAX_STATES];
+        this->mapAll(data, length, states);
+        return this->accepting[states[this->initial_state]];
+    }
+
+    /**
+     * @brief Checks if the DFA accepts a word
+     * 
+     * @param word The word
+     * @return true if the word is accepted. false otherwise
+     */
+    bool matches(const std::string& word) const {
+        return this->matches(word.data(), word.size());
+    }
+
+    /**
+     * @brief Checks many words, walking four of them together over their common length
+     * 
+     * @param words The words
+     * @param count The number of words
+     * @param results Where the result of each word is written
+     */
+    void matchBatch(const std::string* words, size_t count, bool* results) const {
+        size_t w = 0;
+#ifdef SHUFFLE_X86
+        if (isShuffleSupported()) {
+            for (; w + 4 <= count; w += 4) {
+                const unsigned char* data[4];
+                alignas(16) unsigned char states[4][16];
+                size_t common = words[w].size();
+                for (int j = 0; j < 4; j++) {
+                    data[j] = (const unsigned char*) words[w + j].data();
+                    common = std::min(common, words[w + j].size());
+                    for (int s = 0; s < SHUFFLE_MAX_STATES; s++) {
+                        states[j][s] = (unsigned char) s;
+                    }
+                }
+                shuffleRun4(this->shuffles, data, common, states);
+                for (int j = 0; j < 4; j++) {
+                    this->run(data[j] + common, words[w + j].size() - common, states[j]);
+                    results[w + j] = this->accepting[states[j][this->initial_state]];
+                }
+            }
+        }
+#endif
+        for (; w < count; w++) {
+            results[w] = this->matches(words[w]);
+        }
+    }
+};
+
+/**
+ * @brief A matcher that picks its backend: the shuffle backend when the DFA has at most 16 states and the processor supports it, the table backend otherwise
+ */
+class FastMatcher {
+private:
+    TableMatcher table;
+    std::unique_ptr<ShuffleMatcher> shuffle;
+
+public:
+    // Constructors
+    FastMatcher(DFA dfa) {
+        this->table = TableMatcher(dfa);
+        if (this->table.getStateCount() <= SHUFFLE_MAX_STATES && isShuffleSupported()) {
+            this->shuffle = std::unique_ptr<ShuffleMatcher>(new ShuffleMatcher(this->table));
+        }
+    }
+
+    // Matching
+    /**
+     * @brief Checks if the DFA accepts a word
+     * 
+     * @param data The bytes of the word
+     * @param length The number of bytes
+     * @return true if the word is accepted. false otherwise
+     */
+    bool matches(const char* data, size_t length) const {
+        return this->shuffle ? this->shuffle->matches(data, length) : this->table.matches(data, length);
+    }
+
+    /**
+     * @brief Checks many words
+     * 
+     * @param words The words
+     * @param count The number of words
+     * @param results Where the result of each word is written
+     */
+    void matchBatch(const std::string* words, size_t count, bool* results) const {
+        if (this->shuffle) {
+            this->shuffle->matchBatch(words, count, results);
+        } else {
+            this->table.matchBatch(words, count, results);
+        }
+    }
+
+    // FastMatcher Information
+    /**
+     * @brief Gets the table backend, which is always built
+     * 
+     * @return The table backend
+     */
+    const TableMatcher& getTableMatcher() const {
+        return this->table;
+    }
+
+    /**
+     * @brief Gets the name of the backend in use
+     * 
+     * @return "shuffle" or "table"
+     */
+    std::string getBackendName() const {
+        return this->shuffle ? "shuffle" : "table";
+    }
+};
\ No newline at end of file
@@ -0,0 +1,288 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief A DFA with at most N states over K single-character symbols, stored in fixed-size arrays so that it can be built, reduced and run during constant evaluation. Missing transitions are -1 and go to an implicit dead state. The static_asserts at the end of this file minimize and run one while compiling.
+ */
+template <int N, int K>
+class StaticDFA {
+private:
+    char symbols[K];
+    int transitions[N][K];
+    bool final_states[N];
+    int initial_state;
+    int state_count;
+
+    /**
+     * @brief Gets the next state, numbering the dead state as n
+     * 
+     * @param s The state, or n for the dead state
+     * @param a The index of the symbol
+     * @param n The index given to the dead state
+     * @return The next state, or n for the dead state
+     */
+    constexpr int successor(int s, int a, int n) const {
+        return s == n || this->transitions[s][a] == -1 ? n : this->transitions[s][a];
+    }
+
+public:
+    // Constructors
+    /**
+     * @brief Creates a DFA with N states, no transitions and no final states
+     * 
+     * @param alphabet The K symbols, in order
+     */
+    constexpr StaticDFA(const char (&alphabet)[K + 1]) : symbols(), transitions(), final_states(), initial_state(0), state_count(N) {
+        for (int a = 0; a < K; a++) {
+            this->symbols[a] = alphabet[a];
+        }
+        for (int s = 0; s < N; s++) {
+            for (int a = 0; a < K; a++) {
+                this->transitions[s][a] = -1;
+            }
+        }
+    }
+
+    // StaticDFA Creation
+    /**
+     * @brief Sets the transition of a state with a symbol
+     * 
+     * @param from The state from which the transition starts
+     * @param symbol The index of the symbol that triggers the transition
+     * @param to The state to which the transition goes, or -1
+     */
+    constexpr void setTransition(int from, int symbol, int to) {
+        this->transitions[from][symbol] = to;
+    }
+
+    /**
+     * @brief Sets whether a state is final
+     * 
+     * @param s The state
+     * @param is_final Whether the state is final
+     */
+    constexpr void setFinalState(int s, bool is_final) {
+        this->final_states[s] = is_final;
+    }
+
+    /**
+     * @brief Sets the initial state
+     * 
+     * @param s The state to be set as initial
+     */
+    constexpr void setInitialState(int s) {
+        this->initial_state = s;
+    }
+
+    // StaticDFA Information
+    /**
+     * @brief Gets the number of states in use. Reduced DFAs keep their states in 0..getStateCount()-1
+     * 
+     * @return The number of states
+     */
+    constexpr int getStateCount() const {
+        return this->state_count;
+    }
+
+    /**
+     * @brief Gets the index of a symbol
+     * 
+     * @param c The symbol
+     * @return The index of the symbol, or -1 if it is not in the alphabet
+     */
+    constexpr int getSymbolIndex(char c) const {
+        for (int a = 0; a < K; a++) {
+            if (this->symbols[a] == c) {
+                return a;
+            }
+        }
+        return -1;
+    }
+
+    // StaticDFA Operations
+    /**
+     * @brief Builds a DFA with only the reachable states, numbered in BFS order
+     * 
+     * @return The DFA without unreachable states
+     */
+    constexpr StaticDFA removeUnreachableStates() const {
+        int order[N] = {};
+        int id[N] = {};
+        for (int s = 0; s < N; s++) {
+            id[s] = -1;
+        }
+        int count = 0;
+        order[count] = this->initial_state;
+        id[this->initial_state] = count++;
+        for (int head = 0; head < count; head++) {
+            for (int a = 0; a < K; a++) {
+                int t = this->transitions[order[head]][a];
+                if (t != -1 && id[t] == -1) {
+                    order[count] = t;
+                    id[t] = count++;
+                }
+            }
+        }
+
+        StaticDFA result = *this;
+        for (int s = 0; s < N; s++) {
+            result.final_states[s] = s < count && this->final_states[order[s]];
+            for (int a = 0; a < K; a++) {
+                result.transitions[s][a] = s < count && this->transitions[order[s]][a] != -1 ? id[this->transitions[order[s]][a]] : -1;
+            }
+        }
+        result.initial_state = 0;
+        result.state_count = count;
+        return result;
+    }
+
+    /**
+     * @brief Minimizes the DFA with Moore's refinement. Each round gives two states the same class when they had the same class and their successors had the same classes; the refinement stops when a round creates no class. States equivalent to the dead state are dropped
+     * 
+     * @return The minimal DFA, its states numbered from the initial one
+     */
+    constexpr StaticDFA minimize() const {
+        StaticDFA reachable = this->removeUnreachableStates();
+        int n = reachable.state_count;
+
+        // Classes of the states 0..n-1 and of the dead state, kept at index n
+        int classes[N + 1] = {};
+        int refined[N + 1] = {};
+        int class_count = 0;
+        for (int s = 0; s <= n; s++) {
+            classes[s] = s < n && reachable.final_states[s] ? 1 : 0;
+        }
+        for (bool changed = true; changed;) {
+            int count = 0;
+            for (int s = 0; s <= n; s++) {
+                refined[s] = -1;
+                for (int t = 0; t < s && refined[s] == -1; t++) {
+                    bool same = classes[s] == classes[t];
+                    for (int a = 0; a < K && same; a++) {
+                        same = classes[reachable.successor(s, a, n)] == classes[reachable.successor(t, a, n)];
+                    }
+                    if (same) {
+                        refined[s] = refined[t];
+                    }
+                }
+                if (refined[s] == -1) {
+                    refined[s] = count++;
+                }
+            }
+            changed = count != class_count;
+            class_count = count;
+            for (int s = 0; s <= n; s++) {
+                classes[s] = refined[s];
+            }
+        }
+
+        // Renumbering the classes without the dead one, the initial state first
+        int number[N + 1] = {};
+        for (int c = 0; c <= n; c++) {
+            number[c] = -1;
+        }
+        int count = 0;
+        for (int s = 0; s < n; s++) {
+            if (classes[s] != classes[n] && number[classes[s]] == -1) {
+                number[classes[s]] = count++;
+            }
+        }
+
+        StaticDFA result = reachable;
+        for (int s = 0; s < N; s++) {
+            result.final_states[s] = false;
+            for (int a = 0; a < K; a++) {
+                result.transitions[s][a] = -1;
+            }
+        }
+        for (int s = 0; s < n; s++) {
+            int c = number[classes[s]];
+            if (c == -1) {
+                continue;
+            }
+            result.final_states[c] = reachable.final_states[s];
+            for (int a = 0; a < K; a++) {
+                int t = reachable.transitions[s][a];
+                result.transitions[c][a] = t == -1 ? -1 : number[classes[t]];
+            }
+        }
+        result.initial_state = 0;
+        result.state_count = count;
+        if (count == 0) {
+            result.state_count = 1;
+        }
+        return result;
+    }
+
+    // Matching
+    /**
+     * @brief Checks if the DFA accepts a word of symbol indexes
+     * 
+     * @param word The indexes of the symbols
+     * @param length The number of symbols
+     * @return true if the word is accepted. false otherwise
+     */
+    constexpr bool matchSymbols(const int* word, std::size_t length) const {
+        int s = this->initial_state;
+        for (std::size_t i = 0; i < length; i++) {
+            if (word[i] < 0 || word[i] >= K || this->transitions[s][word[i]] == -1) {
+                return false;
+            }
+            s = this->transitions[s][word[i]];
+        }
+        return this->final_states[s];
+    }
+
+    /**
+     * @brief Checks if the DFA accepts a word
+     * 
+     * @param data The characters of the word
+     * @param length The number of characters
+     * @return true if the word is accepted. false otherwise
+     */
+    constexpr bool match(const char* data, std::size_t length) const {
+        int s = this->initial_state;
+        for (std::size_t i = 0; i < length; i++) {
+            int a = this->getSymbolIndex(data[i]);
+            if (a == -1 || this->transitions[s][a] == -1) {
+                return false;
+            }
+            s = this->transitions[s][a];
+        }
+        return this->final_states[s];
+    }
+};
+
+/**
+ * @brief Builds, during constant evaluation, the minimal DFA of the words over {a, b} ending with a. States 1 and 2 are equivalent and state 3 is unreachable
+ * 
+ * @return The minimal DFA, with 2 states
+ */
+constexpr StaticDFA<4, 2> buildStaticEndsWithA() {
+    StaticDFA<4, 2> dfa("ab");
+    dfa.setTransition(0, 0, 1);
+    dfa.setTransition(0, 1, 0);
+    dfa.setTransition(1, 0, 2);
+    dfa.setTransition(1, 1, 0);
+    dfa.setTransition(2, 0, 2);
+    dfa.setTransition(2, 1, 0);
+    dfa.setTransition(3, 0, 0);
+    dfa.setFinalState(1, true);
+    dfa.setFinalState(2, true);
+    dfa.setFinalState(3, true);
+    return dfa.minimize();
+}
+
+// Checked by every build, so StaticDFA keeps working at compile time
+static_assert(buildStaticEndsWithA().getStateCount() == 2, "StaticDFA::minimize must merge the equivalent states at compile time");
+static_assert(buildStaticEndsWithA().match("aba", 3), "StaticDFA must accept words ending with a");
+static_assert(buildStaticEndsWithA().match("a", 1), "StaticDFA must accept words ending with a");
+static_assert(!buildStaticEndsWithA().match("ab", 2), "StaticDFA must reject words ending with b");
+static_assert(!buildStaticEndsWithA().match("", 0), "StaticDFA must reject the empty word");
+static_assert(!buildStaticEndsWithA().match("ac", 2), "StaticDFA must reject symbols outside its alphabet");
\ No newline at end of file
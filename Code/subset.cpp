@@ -0,0 +1,389 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <vector>
+#include <stdexcept>
+#include "nfa.cpp"
+
+// Largest number of DFA states the subset construction builds before giving up
+#define SUBSET_MAX_STATES (1 << 22)
+
+/**
+ * @brief The ε-closures of the states of an NFA, each one computed the first time it is asked for and kept afterwards
+ */
+class EpsilonClosures {
+private:
+    const NFA* nfa;
+    std::vector<std::vector<int>> closures;
+    std::vector<bool> computed;
+    std::vector<int> stack;
+    std::vector<int> visited;
+    int visit_mark;
+
+public:
+    // Constructors
+    EpsilonClosures(const NFA& nfa) {
+        this->nfa = &nfa;
+        this->closures = std::vector<std::vector<int>>(nfa.getStateCount());
+        this->computed = std::vector<bool>(nfa.getStateCount(), false);
+        this->visited = std::vector<int>(nfa.getStateCount(), 0);
+        this->visit_mark = 0;
+    }
+
+    // EpsilonClosures Information
+    /**
+     * @brief Gets the states reachable from a state through ε-transitions, the state itself included
+     * 
+     * @param s The index of the state
+     * @return The states of the closure
+     */
+    const std::vector<int>& get(int s) {
+        if (this->computed[s]) {
+            return this->closures[s];
+        }
+        this->visit_mark++;
+        std::vector<int>& closure = this->closures[s];
+        this->stack.assign(1, s);
+        this->visited[s] = this->visit_mark;
+        while (this->stack.size() > 0) {
+            int current = this->stack.back();
+            this->stack.pop_back();
+            closure.push_back(current);
+            for (int next : this->nfa->getEpsilonMoves(current)) {
+                if (this->visited[next] != this->visit_mark) {
+                    this->visited[next] = this->visit_mark;
+                    this->stack.push_back(next);
+                }
+            }
+        }
+        this->computed[s] = true;
+        return closure;
+    }
+};
+
+/**
+ * @brief A hash-consing table of sets of NFA states. Every set is a dense bitset of a fixed number of 64 bit words, all of them kept one after the other in a single array, and an open addressing table maps a set to its index, so equal sets are stored once
+ */
+class SuperstateTable {
+private:
+    size_t words;
+    std::vector<unsigned long long> bits;
+    std::vector<unsigned long long> hashes;
+    std::vector<int> slots;
+
+    /**
+     * @brief Hashes a bitset
+     * 
+     * @param set The words of the bitset
+     * @return The hash of the bitset
+     */
+    unsigned long long hash(const unsigned long long* set) const {
+        unsigned long long h = 14695981039346656037ULL;
+        for (size_t i = 0; i < this->words; i++) {
+            h = (h ^ set[i]) * 1099511628211ULL;
+            h ^= h >> 29;
+        }
+        return h;
+    }
+
+    /**
+     * @brief Doubles the number of slots and places every set again
+     */
+    void grow() {
+        this->slots.assign(this->slots.size() * 2, NO_STATE);
+        size_t mask = this->slots.size() - 1;
+        for (int id = 0; id < this->size(); id++) {
+            size_t slot = this->hashes[id] & mask;
+            while (this->slots[slot] != NO_STATE) {
+                slot = (slot + 1) & mask;
+            }
+            this->slots[slot] = id;
+        }
+    }
+
+public:
+    // Constructors
+    /**
+     * @brief Creates an empty table
+     * 
+     * @param state_count The number of NFA states, which fixes the size of the bitsets
+     */
+    SuperstateTable(int state_count) {
+        this->words = std::max((size_t) 1, ((size_t) state_count + 63) / 64);
+        this->slots = std::vector<int>(1024, NO_STATE);
+    }
+
+    // SuperstateTable Operations
+    /**
+     * @brief Gets the index of a set, adding it when it is not in the table yet
+     * 
+     * @param set The words of the bitset
+     * @param inserted Receives whether the set was added
+     * @return The index of the set
+     */
+    int intern(const unsigned long long* set, bool* inserted) {
+        unsigned long long h = this->hash(set);
+        size_t mask = this->slots.size() - 1;
+        size_t slot = h & mask;
+        while (this->slots[slot] != NO_STATE) {
+            int id = this->slots[slot];
+            if (this->hashes[id] == h && std::equal(set, set + this->words, this->get(id))) {
+                *inserted = false;
+                return id;
+            }
+            slot = (slot + 1) & mask;
+        }
+        int id = this->size();
+        this->bits.insert(this->bits.end(), set, set + this->words);
+        this->hashes.push_back(h);
+        this->slots[slot] = id;
+        if ((size_t) this->size() * 2 > this->slots.size()) {
+            this->grow();
+        }
+        *inserted = true;
+        return id;
+    }
+
+    /**
+     * @brief Removes every set, keeping the memory already allocated
+     */
+    void clear() {
+        this->bits.clear();
+        this->hashes.clear();
+        std::fill(this->slots.begin(), this->slots.end(), NO_STATE);
+    }
+
+    // SuperstateTable Information
+    /**
+     * @brief Gets the words of a set
+     * 
+     * @param id The index of the set
+     * @return The words of the bitset
+     */
+    const unsigned long long* get(int id) const {
+        return this->bits.data() + (size_t) id * this->words;
+    }
+
+    /**
+     * @brief Gets the number of words of every bitset
+     * 
+     * @return The number of words
+     */
+    size_t getWordCount() const {
+        return this->words;
+    }
+
+    /**
+     * @brief Gets the number of sets
+     * 
+     * @return The number of sets
+     */
+    int size() const {
+        return (int) this->hashes.size();
+    }
+
+    /**
+     * @brief Gets the memory used by the sets and the table
+     * 
+     * @return The number of bytes
+     */
+    size_t getBytes() const {
+        return this->bits.capacity() * sizeof(unsigned long long) + this->hashes.capacity() * sizeof(unsigned long long) + this->slots.capacity() * sizeof(int);
+    }
+};
+
+/**
+ * @brief Computes the successors of sets of NFA states: for every symbol, the union of the ε-closures of the targets of the states of the set. The successors are accumulated in one bitset per symbol, and only the symbols actually read are visited and cleared
+ */
+class SubsetStepper {
+private:
+    const NFA* nfa;
+    EpsilonClosures closures;
+    size_t words;
+    std::vector<unsigned long long> successors;
+    std::vector<bool> used;
+    std::vector<int> used_symbols;
+
+public:
+    // Constructors
+    SubsetStepper(const NFA& nfa) : closures(nfa) {
+        this->nfa = &nfa;
+        this->words = std::max((size_t) 1, ((size_t) nfa.getStateCount() + 63) / 64);
+        this->successors = std::vector<unsigned long long>(this->words * nfa.getSymbolCount(), 0);
+        this->used = std::vector<bool>(nfa.getSymbolCount(), false);
+    }
+
+    // SubsetStepper Operations
+    /**
+     * @brief Writes the ε-closure of the initial states
+     * 
+     * @param set Receives the words of the bitset
+     */
+    void getInitialSet(unsigned long long* set) {
+        std::fill(set, set + this->words, 0ULL);
+        for (int s : this->nfa->getInitialStates()) {
+            for (int t : this->closures.get(s)) {
+                set[t >> 6] |= 1ULL << (t & 63);
+            }
+        }
+    }
+
+    /**
+     * @brief Computes the successors of a set with every symbol. The previous successors are cleared first
+     * 
+     * @param set The words of the bitset
+     * @return The symbols with a non-empty successor, whose bitsets are given by getSuccessor
+     */
+    const std::vector<int>& step(const unsigned long long* set) {
+        for (int a : this->used_symbols) {
+            std::fill(this->successors.begin() + a * this->words, this->successors.begin() + (a + 1) * this->words, 0ULL);
+            this->used[a] = false;
+        }
+        this->used_symbols.clear();
+        for (size_t w = 0; w < this->words; w++) {
+            for (unsigned long long word = set[w]; word != 0; word &= word - 1) {
+                int s = (int) (w * 64 + __builtin_ctzll(word));
+                for (std::pair<int, int> move : this->nfa->getMoves(s)) {
+                    unsigned long long* successor = this->successors.data() + move.first * this->words;
+                    if (!this->used[move.first]) {
+                        this->used[move.first] = true;
+                        this->used_symbols.push_back(move.first);
+                    }
+                    for (int t : this->closures.get(move.second)) {
+                        successor[t >> 6] |= 1ULL << (t & 63);
+                    }
+                }
+            }
+        }
+        return this->used_symbols;
+    }
+
+    /**
+     * @brief Computes the successor of a set with a single symbol, finding the moves of each state with a binary search
+     * 
+     * @param set The words of the bitset
+     * @param a The index of the symbol
+     * @param successor Receives the words of the successor
+     * @return true if the successor is not empty. false otherwise
+     */
+    bool stepSymbol(const unsigned long long* set, int a, unsigned long long* successor) {
+        std::fill(successor, successor + this->words, 0ULL);
+        bool found = false;
+        for (size_t w = 0; w < this->words; w++) {
+            for (unsigned long long word = set[w]; word != 0; word &= word - 1) {
+                const std::vector<std::pair<int, int>>& moves = this->nfa->getMoves((int) (w * 64 + __builtin_ctzll(word)));
+                for (auto it = std::lower_bound(moves.begin(), moves.end(), std::make_pair(a, 0)); it != moves.end() && it->first == a; it++) {
+                    found = true;
+                    for (int t : this->closures.get(it->second)) {
+                        successor[t >> 6] |= 1ULL << (t & 63);
+                    }
+                }
+            }
+        }
+        return found;
+    }
+
+    /**
+     * @brief Gets the successor of the last stepped set with a symbol
+     * 
+     * @param a The index of the symbol
+     * @return The words of the bitset
+     */
+    const unsigned long long* getSuccessor(int a) const {
+        return this->successors.data() + a * this->words;
+    }
+
+    /**
+     * @brief Checks if a set contains a final state
+     * 
+     * @param set The words of the bitset
+     * @return true if the set is accepting. false otherwise
+     */
+    bool isAccepting(const unsigned long long* set) const {
+        for (size_t w = 0; w < this->words; w++) {
+            for (unsigned long long word = set[w]; word != 0; word &= word - 1) {
+                if (this->nfa->isFinalState((int) (w * 64 + __builtin_ctzll(word)))) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Gets the label of a set: the label of highest priority among its final states, or among all its states when none is final
+     * 
+     * @param set The words of the bitset
+     * @return The number of the label, or NO_LABEL
+     */
+    int getLabel(const unsigned long long* set) const {
+        int final_label = NO_LABEL;
+        int any_label = NO_LABEL;
+        bool accepting = false;
+        for (size_t w = 0; w < this->words; w++) {
+            for (unsigned long long word = set[w]; word != 0; word &= word - 1) {
+                int s = (int) (w * 64 + __builtin_ctzll(word));
+                int label = this->nfa->getStateLabel(s);
+                accepting = accepting || this->nfa->isFinalState(s);
+                if (label == NO_LABEL) {
+                    continue;
+                }
+                if (this->nfa->isFinalState(s) && (final_label == NO_LABEL || label < final_label)) {
+                    final_label = label;
+                }
+                if (any_label == NO_LABEL || label < any_label) {
+                    any_label = label;
+                }
+            }
+        }
+        return accepting ? final_label : any_label;
+    }
+};
+
+/**
+ * @brief Determinizes an NFA with the subset construction. Only the sets reachable from the closure of the initial states are built, each one interned in a SuperstateTable as a dense bitset, and the empty set is left out as missing transitions. When states of a set have different labels, the set takes the one that was numbered first among its final states, like the first rule of a lexer specification
+ * 
+ * @param nfa The NFA
+ * @param max_states The largest number of DFA states that may be built
+ * @return The DFA, its states named by their order of construction
+ */
+IndexedDFA determinize(const NFA& nfa, size_t max_states) {
+    SuperstateTable table = SuperstateTable(nfa.getStateCount());
+    SubsetStepper stepper = SubsetStepper(nfa);
+    IndexedDFA dfa = IndexedDFA(nfa.getSymbols());
+    if (nfa.getInitialStates().size() == 0) {
+        return dfa;
+    }
+
+    std::vector<unsigned long long> set(table.getWordCount());
+    bool inserted = false;
+    stepper.getInitialSet(set.data());
+    table.intern(set.data(), &inserted);
+    dfa.addState("0", stepper.isAccepting(set.data()));
+    dfa.setInitialState(0);
+    if (nfa.hasLabels()) {
+        dfa.setStateLabel(0, nfa.getLabelName(stepper.getLabel(set.data())));
+    }
+    for (int id = 0; id < table.size(); id++) {
+        // The words are copied because interning may move the array
+        set.assign(table.get(id), table.get(id) + table.getWordCount());
+        for (int a : stepper.step(set.data())) {
+            int target = table.intern(stepper.getSuccessor(a), &inserted);
+            if (inserted) {
+                if ((size_t) table.size() > max_states) {
+                    throw std::runtime_error("The subset construction exceeded " + std::to_string(max_states) + " states.");
+                }
+                dfa.addState(std::to_string(target), stepper.isAccepting(stepper.getSuccessor(a)));
+                if (nfa.hasLabels()) {
+                    dfa.setStateLabel(target, nfa.getLabelName(stepper.getLabel(stepper.getSuccessor(a))));
+                }
+            }
+            dfa.setTransition(id, a, target);
+        }
+    }
+    return dfa;
+}
\ No newline at end of file
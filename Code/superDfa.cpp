@@ -3,6 +3,8 @@
  * @author Felipe Nepomuceno Coelho (689661)
  */
 
+#pragma once
+
 #include <set>
 #include <map>
 #include <utility>
@@ -22,6 +24,7 @@ private:
     std::map<superTransition, superState> transitions;
     superState initial_state;
     std::set<superState> final_states;
+    std::map<superState, std::string> labels;
 
 public:
     // Constructors
@@ -31,6 +34,7 @@ public:
         this->transitions = std::map<superTransition, superState>();
         this->initial_state = superState();
         this->final_states = std::set<superState>();
+        this->labels = std::map<superState, std::string>();
     }
 
     SuperDFA(std::set<superState> states,
@@ -43,6 +47,7 @@ public:
         this->transitions = transitions;
         this->initial_state = initial_state;
         this->final_states = final_states;
+        this->labels = std::map<superState, std::string>();
     }
 
     // SuperDFA Creation
@@ -93,6 +98,20 @@ public:
         this->final_states.insert(s);
     }
 
+    /**
+     * @brief Sets the label of a super state, the label shared by its states
+     * 
+     * @param s The super state
+     * @param label The label, or an empty string for none
+     */
+    void setStateLabel(superState s, std::string label) {
+        if (label == "") {
+            this->labels.erase(s);
+            return;
+        }
+        this->labels[s] = label;
+    }
+
     // SuperDFA Information
     /**
      * @brief Checks if a super state is a final super state
@@ -215,6 +234,10 @@ public:
             }
             state_name.pop_back();
             dfa.addState(state_name);
+            auto label = this->labels.find(super_state);
+            if (label != this->labels.end()) {
+                dfa.setStateLabel(state_name, label->second);
+            }
         }
 
         // Setting up initial state
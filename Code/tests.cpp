@@ -0,0 +1,246 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#include <iostream>
+#include <random>
+#include "pugixml/pugixml.hpp"
+#include "incremental.cpp"
+#include "anytime.cpp"
+#include "tokenizer.cpp"
+
+// Seed of the random automata, so a failure can be reproduced
+#define TESTS_SEED 47
+
+// Number of random automata each check runs on
+#define TESTS_ROUNDS 2000
+
+// Number of random edits made on each automaton by the incremental check
+#define TESTS_EDITS 15
+
+// Length of each of the two equivalent chains of the anytime check
+#define TESTS_CHAIN_LENGTH 300
+
+std::mt19937 rng(TESTS_SEED);
+
+/**
+ * @brief Builds a random DFA over the symbols a, b and c whose final states are sometimes labelled with A, B or C
+ * 
+ * @param n The number of states
+ * @param density The percentage of the transitions that exist
+ * @return The DFA, with its initial state named 0
+ */
+DFA buildRandomLabelledDfa(int n, int density) {
+    DFA dfa = DFA();
+    std::string alphabet = "abc";
+    for (char c : alphabet) {
+        dfa.addSymbol(std::string(1, c));
+    }
+    for (int s = 0; s < n; s++) {
+        dfa.addState(std::to_string(s));
+        if (rng() % 3 == 0) {
+            dfa.addFinalState(std::to_string(s));
+            if (rng() % 4 != 0) {
+                dfa.setStateLabel(std::to_string(s), std::string(1, 'A' + rng() % 3));
+            }
+        }
+    }
+    for (int s = 0; s < n; s++) {
+        for (char c : alphabet) {
+            if ((int) (rng() % 100) < density) {
+                dfa.addTransition(std::to_string(s), std::string(1, c), std::to_string(rng() % n));
+            }
+        }
+    }
+    dfa.setInitialState("0");
+    return dfa;
+}
+
+/**
+ * @brief Splits a text into tokens the slow way: from each position the DFA is run until it dies, and the token ends at the last accepting state met
+ * 
+ * @param dfa The lexer DFA
+ * @param tokenizer The tokenizer whose tag numbers are used
+ * @param text The text
+ * @return The lexemes, with LEXEME_ERROR for a byte that starts no token
+ */
+std::vector<lexeme> tokenizeNaively(const IndexedDFA& dfa, const Tokenizer& tokenizer, const std::string& text) {
+    std::vector<lexeme> lexemes;
+    size_t p = 0;
+    while (p < text.size()) {
+        lexeme l;
+        l.tag = LEXEME_ERROR;
+        l.offset = p;
+        l.length = 1;
+        int s = dfa.getInitialState();
+        for (size_t q = p; q < text.size() && s != NO_STATE; q++) {
+            int a = dfa.getSymbolIndex(std::string(1, text[q]));
+            s = a == -1 ? NO_STATE : dfa.transite(s, a);
+            if (s != NO_STATE && dfa.isFinalState(s)) {
+                l.length = q + 1 - p;
+                for (int t = 0; t < tokenizer.getTagCount(); t++) {
+                    if (tokenizer.getTagName(t) == dfa.getStateLabel(s)) {
+                        l.tag = t;
+                    }
+                }
+            }
+        }
+        lexemes.push_back(l);
+        p += l.length;
+    }
+    return lexemes;
+}
+
+/**
+ * @brief Checks the tokenizer against tokenizeNaively on random labelled DFAs, feeding random texts in chunks of random sizes and reading the lexemes in batches of random sizes
+ * 
+ * @return true if every lexeme matched. false otherwise
+ */
+bool checkTokenizer() {
+    for (int round = 0; round < TESTS_ROUNDS; round++) {
+        DFA dfa = buildRandomLabelledDfa(1 + rng() % 12, 67);
+        Tokenizer tokenizer = Tokenizer(dfa);
+        std::string text;
+        int length = rng() % 200;
+        for (int i = 0; i < length; i++) {
+            text += "abcd"[rng() % 4];
+        }
+        std::vector<lexeme> expected = tokenizeNaively(IndexedDFA(dfa), tokenizer, text);
+
+        std::vector<lexeme> lexemes;
+        lexeme batch[8];
+        size_t count;
+        for (size_t position = 0; position < text.size();) {
+            size_t chunk_length = std::min((size_t) (1 + rng() % 10), text.size() - position);
+            tokenizer.feed(text.data() + position, chunk_length);
+            while ((count = tokenizer.next(batch, 1 + rng() % 8)) > 0) {
+                lexemes.insert(lexemes.end(), batch, batch + count);
+            }
+            position += chunk_length;
+        }
+        tokenizer.finish();
+        while ((count = tokenizer.next(batch, 8)) > 0) {
+            lexemes.insert(lexemes.end(), batch, batch + count);
+        }
+
+        bool equal = lexemes.size() == expected.size();
+        for (size_t i = 0; i < lexemes.size() && equal; i++) {
+            equal = lexemes[i].tag == expected[i].tag && lexemes[i].offset == expected[i].offset && lexemes[i].length == expected[i].length;
+        }
+        if (!equal) {
+            std::cout << "Tokenizer: wrong lexemes in round " << round << ".\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks the incremental minimal DFA on random labelled DFAs: it must start as the minimization of the DFA, labels included, and after each random edit it must be the minimization of the DFA edited the same way
+ * 
+ * @return true if every edit kept the DFA minimal. false otherwise
+ */
+bool checkIncrementalEdits() {
+    for (int round = 0; round < TESTS_ROUNDS; round++) {
+        IndexedDFA dfa = IndexedDFA(buildRandomLabelledDfa(1 + rng() % 25, 30 + rng() % 70));
+        IncrementalMinimalDFA editor = IncrementalMinimalDFA(dfa);
+        if (IndexedDFA(minimizeIndexedDfa(dfa).convertToDfa()).serialize() != IndexedDFA(editor.convertToIndexedDfa().convertToDfa()).serialize()) {
+            std::cout << "Incremental minimal DFA: wrong DFA before the edits of round " << round << ".\n";
+            return false;
+        }
+        for (int edit = 0; edit < TESTS_EDITS; edit++) {
+            IndexedDFA edited = editor.convertToIndexedDfa();
+            int s = rng() % edited.getStateCount();
+            int t = rng() % edited.getStateCount();
+            int a = rng() % edited.getSymbolCount();
+            int from = editor.getStateIndex(edited.getStateName(s));
+            int option = rng() % 3;
+            if (option == 0) {
+                editor.setTransition(from, a, editor.getStateIndex(edited.getStateName(t)));
+                edited.setTransition(s, a, t);
+            } else if (option == 1) {
+                editor.removeTransition(from, a);
+                edited.setTransition(s, a, NO_STATE);
+            } else {
+                editor.setFinalState(from, !editor.isFinalState(from));
+                edited.setFinalState(s, !edited.isFinalState(s));
+            }
+
+            IndexedDFA expected = minimizeIndexedDfa(IndexedDFA(edited.convertToDfa()));
+            IndexedDFA result = editor.convertToIndexedDfa();
+            if (IndexedDFA(expected.convertToDfa()).serialize() != IndexedDFA(result.convertToDfa()).serialize()) {
+                std::cout << "Incremental minimal DFA: wrong DFA after edit " << edit << " of round " << round << ".\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks the anytime minimizer on random labelled DFAs run in slices of random sizes, which must end with the minimal DFA, and on a DFA with two equivalent chains, whose number of classes must drop before the minimization is complete
+ * 
+ * @return true if every result was right. false otherwise
+ */
+bool checkAnytimeMinimizer() {
+    for (int round = 0; round < TESTS_ROUNDS; round++) {
+        IndexedDFA dfa = IndexedDFA(buildRandomLabelledDfa(1 + rng() % 25, 30 + rng() % 70));
+        AnytimeMinimizer minimizer = AnytimeMinimizer(dfa);
+        while (!minimizer.run(1 + rng() % 20, std::chrono::hours(1), nullptr)) {
+            if (minimizer.isComplete()) {
+                std::cout << "Anytime minimizer: complete run reported as unfinished in round " << round << ".\n";
+                return false;
+            }
+        }
+        IndexedDFA expected = minimizeIndexedDfa(dfa);
+        if (IndexedDFA(expected.convertToDfa()).serialize() != IndexedDFA(minimizer.getResult().convertToDfa()).serialize()) {
+            std::cout << "Anytime minimizer: wrong DFA in round " << round << ".\n";
+            return false;
+        }
+    }
+
+    // A state leading to two chains that only differ in the names of their states
+    IndexedDFA chains = IndexedDFA(std::vector<std::string>{"a", "b"});
+    chains.addState("i", false);
+    for (int i = 0; i < 2 * TESTS_CHAIN_LENGTH; i++) {
+        chains.addState(std::to_string(i), i % TESTS_CHAIN_LENGTH == TESTS_CHAIN_LENGTH - 1);
+    }
+    for (int i = 0; i < 2 * TESTS_CHAIN_LENGTH; i++) {
+        if (i % TESTS_CHAIN_LENGTH != TESTS_CHAIN_LENGTH - 1) {
+            chains.setTransition(i + 1, 0, i + 2);
+        }
+    }
+    chains.setTransition(0, 0, 1);
+    chains.setTransition(0, 1, 1 + TESTS_CHAIN_LENGTH);
+    chains.setInitialState(0);
+    AnytimeMinimizer minimizer = AnytimeMinimizer(chains);
+    int initial_count = minimizer.getClassCount();
+    bool dropped = false;
+    while (!minimizer.run(TESTS_CHAIN_LENGTH, std::chrono::hours(1), nullptr)) {
+        dropped = dropped || minimizer.getClassCount() < initial_count;
+    }
+    if (!dropped || minimizer.getResult().getStateCount() != TESTS_CHAIN_LENGTH + 1) {
+        std::cout << "Anytime minimizer: no merge before the minimization was complete.\n";
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    bool passed = true;
+    std::cout << "Tokenizer against the naive maximal munch... ";
+    bool result = checkTokenizer();
+    std::cout << (result ? "ok\n" : "FAILED\n");
+    passed = passed && result;
+    std::cout << "Incremental minimal DFA against a full minimization after random edits... ";
+    result = checkIncrementalEdits();
+    std::cout << (result ? "ok\n" : "FAILED\n");
+    passed = passed && result;
+    std::cout << "Anytime minimizer against a full minimization, merging before it is complete... ";
+    result = checkAnytimeMinimizer();
+    std::cout << (result ? "ok\n" : "FAILED\n");
+    passed = passed && result;
+    return passed ? 0 : 1;
+}
\ No newline at end of file
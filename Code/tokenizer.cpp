@@ -0,0 +1,274 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <map>
+#include <stdexcept>
+#include "matcher.cpp"
+
+// Tag of the lexemes made of a byte that starts no token
+#define LEXEME_ERROR -1
+
+// Row information of the rows that are neither accepting nor dead
+#define TOKENIZER_PLAIN_ROW -1
+
+// Row information of the dead row
+#define TOKENIZER_DEAD_ROW -2
+
+/**
+ * @brief A token found by a Tokenizer: its tag and where it is in the whole input
+ */
+struct lexeme {
+    int tag;
+    unsigned long long offset;
+    unsigned long long length;
+};
+
+/**
+ * @brief Splits a stream of bytes into tokens with the longest match rule (maximal munch) over the table of a TableMatcher. Each accepting state tags its tokens with its label, so a single minimized DFA recognizes every kind of token. The input comes in chunks that are read in place: only the lookahead read past the last accepting position of an unfinished token is kept when a chunk ends, since it is the only part that may have to be read again
+ */
+class Tokenizer {
+private:
+    TableMatcher matcher;
+    std::vector<int> row_info;
+    std::vector<std::string> tag_names;
+    const unsigned char* chunk;
+    size_t chunk_length;
+    unsigned long long chunk_offset;
+    std::string tail;
+    unsigned long long tail_offset;
+    int row;
+    int last_tag;
+    unsigned long long token_start;
+    unsigned long long last_end;
+    unsigned long long position;
+    bool finished;
+
+    /**
+     * @brief Ends the current token at its last accepting position, or makes an error lexeme of its first byte when it never accepted, and starts the next token right after it
+     * 
+     * @return The lexeme
+     */
+    lexeme emit() {
+        lexeme l;
+        l.tag = this->last_tag;
+        l.offset = this->token_start;
+        l.length = this->last_tag == LEXEME_ERROR ? 1 : this->last_end - this->token_start;
+        this->token_start += l.length;
+        this->position = this->token_start;
+        this->row = this->matcher.getInitialRow();
+        this->last_tag = LEXEME_ERROR;
+        return l;
+    }
+
+    /**
+     * @brief Keeps the bytes of the current chunk that may be read again, the ones after the position where the next token would start if the current one ended now
+     */
+    void saveTail() {
+        unsigned long long keep_from = this->last_tag == LEXEME_ERROR ? this->token_start + 1 : this->last_end;
+        keep_from = std::min(keep_from, this->position);
+        std::string kept;
+        if (keep_from < this->chunk_offset) {
+            kept = this->tail.substr(keep_from - this->tail_offset);
+        }
+        unsigned long long from = std::max(keep_from, this->chunk_offset);
+        if (this->position > from) {
+            kept.append((const char*) this->chunk + (from - this->chunk_offset), this->position - from);
+        }
+        this->tail.swap(kept);
+        this->tail_offset = keep_from;
+    }
+
+    /**
+     * @brief Checks that the current chunk was fully tokenized and moves past it
+     */
+    void endChunk() {
+        if (this->position != this->chunk_offset + this->chunk_length) {
+            throw std::runtime_error("The previous chunk was not fully tokenized.");
+        }
+        this->saveTail();
+        this->chunk_offset += this->chunk_length;
+        this->chunk = nullptr;
+        this->chunk_length = 0;
+    }
+
+public:
+    // Constructors
+    /**
+     * @brief Compiles a DFA for tokenization. The tag of an accepting state is its label, and the accepting states without a label share the tag of the empty label. Every symbol must be a single byte
+     * 
+     * @param dfa The DFA, usually a minimized lexer
+     */
+    Tokenizer(DFA dfa) : matcher(dfa) {
+        IndexedDFA indexed = IndexedDFA(dfa);
+        int class_count = this->matcher.getClassCount();
+        std::map<std::string, int> tags;
+        this->row_info = std::vector<int>((size_t) this->matcher.getStateCount() * class_count, TOKENIZER_PLAIN_ROW);
+        this->row_info[0] = TOKENIZER_DEAD_ROW;
+        for (int s = 0; s < indexed.getStateCount(); s++) {
+            if (!indexed.isFinalState(s)) {
+                continue;
+            }
+            auto it = tags.find(indexed.getStateLabel(s));
+            if (it == tags.end()) {
+                it = tags.insert(std::make_pair(indexed.getStateLabel(s), (int) this->tag_names.size())).first;
+                this->tag_names.push_back(indexed.getStateLabel(s));
+            }
+            this->row_info[(size_t) (s + 1) * class_count] = it->second;
+        }
+        this->reset();
+    }
+
+    /**
+     * @brief Compiles the DFA of an exported JFLAP file, with the labels of its states as tags
+     * 
+     * @param file_path The path of the file
+     * @return The tokenizer
+     */
+    static Tokenizer fromJffFile(std::string file_path) {
+        DFA dfa;
+        if (!readDfaFromJff(file_path, &dfa)) {
+            throw std::runtime_error("Could not read " + file_path + ".");
+        }
+        return Tokenizer(dfa);
+    }
+
+    // Tokenizer Operations
+    /**
+     * @brief Starts a new input
+     */
+    void reset() {
+        this->chunk = nullptr;
+        this->chunk_length = 0;
+        this->chunk_offset = 0;
+        this->tail.clear();
+        this->tail_offset = 0;
+        this->row = this->matcher.getInitialRow();
+        this->last_tag = LEXEME_ERROR;
+        this->token_start = 0;
+        this->last_end = 0;
+        this->position = 0;
+        this->finished = false;
+    }
+
+    /**
+     * @brief Gives the next chunk of the input. The bytes are read in place, so they must stay valid until next returns 0
+     * 
+     * @param data The bytes of the chunk
+     * @param length The number of bytes
+     */
+    void feed(const char* data, size_t length) {
+        if (this->finished) {
+            throw std::runtime_error("No chunk can be fed after the input is finished.");
+        }
+        this->endChunk();
+        this->chunk = (const unsigned char*) data;
+        this->chunk_length = length;
+    }
+
+    /**
+     * @brief Tells that the input is over, so the token being read is ended by the next calls to next
+     */
+    void finish() {
+        if (!this->finished) {
+            this->endChunk();
+            this->finished = true;
+        }
+    }
+
+    /**
+     * @brief Writes the next lexemes of the input. A token that reaches the end of the chunk is only written once a later chunk, or the end of the input, tells where it ends
+     * 
+     * @param out Where the lexemes are written
+     * @param capacity The largest number of lexemes to write
+     * @return The number of lexemes written. 0 when the chunk is over, and after finish when the input is over
+     */
+    size_t next(lexeme* out, size_t capacity) {
+        const int* table = this->matcher.getTable();
+        const unsigned char* classes = this->matcher.getByteClasses();
+        const int* info = this->row_info.data();
+        unsigned long long end = this->chunk_offset + this->chunk_length;
+        size_t count = 0;
+        while (count < capacity) {
+            int i;
+            if (this->position < this->chunk_offset) {
+                // Reading again the lookahead kept from the previous chunks
+                unsigned char byte = (unsigned char) this->tail[this->position - this->tail_offset];
+                this->position++;
+                this->row = table[this->row + classes[byte]];
+                i = info[this->row];
+            } else if (this->position < end) {
+                const unsigned char* p = this->chunk + (this->position - this->chunk_offset);
+                const unsigned char* stop = this->chunk + this->chunk_length;
+                const unsigned char* accepted = nullptr;
+                int r = this->row;
+                int tag = this->last_tag;
+                i = TOKENIZER_PLAIN_ROW;
+                while (p < stop) {
+                    r = table[r + classes[*p++]];
+                    i = info[r];
+                    if (i >= 0) {
+                        tag = i;
+                        accepted = p;
+                    } else if (i == TOKENIZER_DEAD_ROW) {
+                        break;
+                    }
+                }
+                this->row = r;
+                this->position = this->chunk_offset + (p - this->chunk);
+                if (accepted != nullptr) {
+                    this->last_tag = tag;
+                    this->last_end = this->chunk_offset + (accepted - this->chunk);
+                }
+                if (i != TOKENIZER_DEAD_ROW) {
+                    i = TOKENIZER_PLAIN_ROW;
+                }
+            } else if (this->finished && this->position > this->token_start) {
+                i = TOKENIZER_DEAD_ROW;
+            } else {
+                break;
+            }
+            if (i >= 0) {
+                this->last_tag = i;
+                this->last_end = this->position;
+            } else if (i == TOKENIZER_DEAD_ROW) {
+                out[count++] = this->emit();
+            }
+        }
+        return count;
+    }
+
+    // Tokenizer Information
+    /**
+     * @brief Gets the number of tags
+     * 
+     * @return The number of tags
+     */
+    int getTagCount() const {
+        return (int) this->tag_names.size();
+    }
+
+    /**
+     * @brief Gets the name of a tag
+     * 
+     * @param tag The tag
+     * @return The label of the accepting states of the tag
+     */
+    const std::string& getTagName(int tag) const {
+        return this->tag_names[tag];
+    }
+
+    /**
+     * @brief Gets the number of bytes kept from the previous chunks
+     * 
+     * @return The size of the kept lookahead
+     */
+    size_t getTailSize() const {
+        return this->tail.size();
+    }
+};
\ No newline at end of file
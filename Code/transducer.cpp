@@ -0,0 +1,192 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <map>
+#include "partition.cpp"
+
+/**
+ * @brief The kinds of machines with outputs that JFLAP saves
+ */
+enum machineType {
+    MACHINE_MOORE,
+    MACHINE_MEALY
+};
+
+/**
+ * @brief A deterministic Moore or Mealy machine: a DFA whose states (Moore) or transitions (Mealy) write an output. Missing transitions halt the machine, just like the dead state of a DFA
+ */
+class Transducer {
+private:
+    machineType type;
+    IndexedDFA dfa;
+    std::vector<std::string> state_outputs;
+    std::vector<std::string> transition_outputs;
+
+public:
+    // Constructors
+    Transducer() {
+        this->type = MACHINE_MOORE;
+        this->dfa = IndexedDFA();
+        this->state_outputs = std::vector<std::string>();
+        this->transition_outputs = std::vector<std::string>();
+    }
+
+    /**
+     * @brief Creates a machine over a DFA, with every output empty
+     * 
+     * @param type Whether the outputs are written by the states or by the transitions
+     * @param dfa The underlying DFA
+     */
+    Transducer(machineType type, const IndexedDFA& dfa) {
+        this->type = type;
+        this->dfa = dfa;
+        this->state_outputs = std::vector<std::string>(dfa.getStateCount());
+        this->transition_outputs = std::vector<std::string>((size_t) dfa.getStateCount() * dfa.getSymbolCount());
+    }
+
+    // Transducer Creation
+    /**
+     * @brief Sets the output a state writes when it is reached
+     * 
+     * @param s The index of the state
+     * @param output The output
+     */
+    void setStateOutput(int s, std::string output) {
+        this->state_outputs[s] = output;
+    }
+
+    /**
+     * @brief Sets the output a transition writes when it is taken
+     * 
+     * @param s The index of the state from which the transition starts
+     * @param a The index of the symbol that triggers the transition
+     * @param output The output
+     */
+    void setTransitionOutput(int s, int a, std::string output) {
+        this->transition_outputs[(size_t) s * this->dfa.getSymbolCount() + a] = output;
+    }
+
+    // Transducer Operations
+    /**
+     * @brief Gets the labels of the initial partition, which puts together the states with the same finality, label and outputs: the output of the state for a Moore machine and the outputs of its transitions for a Mealy machine. The dead state gets a label of its own, since halting is not writing an empty output
+     * 
+     * @param dead_label Where the label of the dead state is written
+     * @return One label per state
+     */
+    std::vector<int> getOutputLabels(int* dead_label) const {
+        int n = this->dfa.getStateCount();
+        int k = this->dfa.getSymbolCount();
+        std::vector<int> acceptance = getAcceptanceLabels(this->dfa);
+        std::map<std::vector<std::string>, int> numbers;
+        std::vector<int> labels(n);
+        std::vector<std::string> key;
+        for (int s = 0; s < n; s++) {
+            key.assign(1, std::to_string(acceptance[s]));
+            key.push_back(this->state_outputs[s]);
+            key.insert(key.end(), this->transition_outputs.begin() + (size_t) s * k, this->transition_outputs.begin() + (size_t) (s + 1) * k);
+            labels[s] = numbers.insert(std::make_pair(key, (int) numbers.size())).first->second;
+        }
+        *dead_label = (int) numbers.size();
+        return labels;
+    }
+
+    /**
+     * @brief Minimizes the machine with Hopcroft's partition refinement, starting from the blocks of states with the same outputs, so the outputs are refined together with the transitions in a single run
+     * 
+     * @return The minimal machine, its states named after the first member of their class
+     */
+    Transducer minimize() const {
+        int dead_label;
+        std::vector<int> labels = this->getOutputLabels(&dead_label);
+        std::vector<int> classes = computeEquivalenceClasses(this->dfa, labels, dead_label);
+        Transducer minimal = Transducer(this->type, buildIndexedQuotient(this->dfa, classes));
+
+        // The quotient numbers the classes in order of first appearance, so its outputs come from the first members
+        std::vector<bool> seen(classes.size(), false);
+        int c = 0;
+        for (int s = 0; s < this->dfa.getStateCount(); s++) {
+            if (seen[classes[s]]) {
+                continue;
+            }
+            seen[classes[s]] = true;
+            minimal.setStateOutput(c, this->getStateOutput(s));
+            for (int a = 0; a < this->dfa.getSymbolCount(); a++) {
+                minimal.setTransitionOutput(c, a, this->getTransitionOutput(s, a));
+            }
+            c++;
+        }
+        return minimal;
+    }
+
+    // Transducer Information
+    /**
+     * @brief Gets the kind of machine
+     * 
+     * @return MACHINE_MOORE or MACHINE_MEALY
+     */
+    machineType getType() const {
+        return this->type;
+    }
+
+    /**
+     * @brief Gets the underlying DFA
+     * 
+     * @return The DFA
+     */
+    const IndexedDFA& getDfa() const {
+        return this->dfa;
+    }
+
+    /**
+     * @brief Gets the output a state writes when it is reached
+     * 
+     * @param s The index of the state
+     * @return The output
+     */
+    const std::string& getStateOutput(int s) const {
+        return this->state_outputs[s];
+    }
+
+    /**
+     * @brief Gets the output a transition writes when it is taken
+     * 
+     * @param s The index of the state from which the transition starts
+     * @param a The index of the symbol that triggers the transition
+     * @return The output
+     */
+    const std::string& getTransitionOutput(int s, int a) const {
+        return this->transition_outputs[(size_t) s * this->dfa.getSymbolCount() + a];
+    }
+
+    /**
+     * @brief Runs the machine on a word
+     * 
+     * @param word The symbols of the word
+     * @param output Where the written outputs are concatenated
+     * @return true if the whole word was read. false if the machine halted on a missing transition
+     */
+    bool translate(const std::vector<std::string>& word, std::string* output) const {
+        output->clear();
+        int s = this->dfa.getInitialState();
+        if (s == NO_STATE) {
+            return false;
+        }
+        *output += this->getStateOutput(s);
+        for (const std::string& symbol : word) {
+            int a = this->dfa.getSymbolIndex(symbol);
+            int t = a == -1 ? NO_STATE : this->dfa.transite(s, a);
+            if (t == NO_STATE) {
+                return false;
+            }
+            *output += this->getTransitionOutput(s, a) + this->getStateOutput(t);
+            s = t;
+        }
+        return true;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,95 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <vector>
+
+/**
+ * @brief A disjoint-set forest over the integers 0..n-1, with path compression and union by rank
+ */
+class UnionFind {
+private:
+    std::vector<int> parent;
+    std::vector<int> rank;
+
+public:
+    // Constructors
+    UnionFind() {
+        this->parent = std::vector<int>();
+        this->rank = std::vector<int>();
+    }
+
+    UnionFind(int n) {
+        this->parent = std::vector<int>(n);
+        this->rank = std::vector<int>(n, 0);
+        for (int i = 0; i < n; i++) {
+            this->parent[i] = i;
+        }
+    }
+
+    // UnionFind Operations
+    /**
+     * @brief Gets the representative of the set of an element
+     * 
+     * @param x The element
+     * @return The representative of the set that contains x
+     */
+    int find(int x) {
+        int root = x;
+        while (this->parent[root] != root) {
+            root = this->parent[root];
+        }
+        while (this->parent[x] != root) {
+            int next = this->parent[x];
+            this->parent[x] = root;
+            x = next;
+        }
+        return root;
+    }
+
+    /**
+     * @brief Merges the sets of two elements
+     * 
+     * @param x The first element
+     * @param y The second element
+     * @return true if the sets were different. false if x and y were already together
+     */
+    bool unite(int x, int y) {
+        x = this->find(x);
+        y = this->find(y);
+        if (x == y) {
+            return false;
+        }
+        if (this->rank[x] < this->rank[y]) {
+            std::swap(x, y);
+        }
+        this->parent[y] = x;
+        if (this->rank[x] == this->rank[y]) {
+            this->rank[x]++;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Adds a new element in its own set
+     * 
+     * @return The new element
+     */
+    int add() {
+        this->parent.push_back((int) this->parent.size());
+        this->rank.push_back(0);
+        return (int) this->parent.size() - 1;
+    }
+
+    /**
+     * @brief Gets the number of elements
+     * 
+     * @return The number of elements
+     */
+    int size() {
+        return (int) this->parent.size();
+    }
+};
\ No newline at end of file
@@ -3,7 +3,12 @@
  * @author Felipe Nepomuceno Coelho (689661)
  */
 
+#pragma once
+
 #include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
 #include <string>
 #include <algorithm>
 #include <set>
@@ -19,6 +24,39 @@ inline bool existsFile(const std::string& name) {
   return (stat (name.c_str(), &buffer) == 0); 
 }
 
+/**
+ * @brief Creates a directory if it does not exist yet
+ * 
+ * @param name A string containing the directory path
+ * @return true if the directory exists after the call. false otherwise
+ */
+inline bool createDirectory(const std::string& name) {
+  if (existsFile(name)) {
+    return true;
+  }
+#ifdef _WIN32
+  return _mkdir(name.c_str()) == 0;
+#else
+  return mkdir(name.c_str(), 0755) == 0;
+#endif
+}
+
+/**
+ * @brief Computes the 64 bits FNV-1a hash of a string
+ * 
+ * @param data The string to be hashed
+ * @param seed The initial value of the hash. Different seeds give independent hashes
+ * @return The hash of the string
+ */
+inline unsigned long long fnv1aHash(const std::string& data, unsigned long long seed = 14695981039346656037ULL) {
+  unsigned long long hash = seed;
+  for (unsigned char c : data) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
 template <typename T>
 /**
  * @brief Checks if a set contains an element
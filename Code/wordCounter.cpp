@@ -0,0 +1,347 @@
+/**
+ * @author Bruno Pena Baêta (696997)
+ * @author Felipe Nepomuceno Coelho (689661)
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <map>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include "partition.cpp"
+
+// The largest prime below 2^32, the default modulus of the counts
+#define COUNT_DEFAULT_MODULUS 4294967291ULL
+// Automata with fewer states than this per thread are counted on a single thread
+#define COUNT_PARALLEL_MIN_STATES 8192
+
+/**
+ * @brief Makes a fixed group of threads wait for each other between two steps
+ */
+class StepBarrier {
+private:
+    int count;
+    std::atomic<int> waiting;
+    std::atomic<unsigned long long> generation;
+
+public:
+    // Constructors
+    StepBarrier(int count) : count(count), waiting(0), generation(0) {}
+
+    // StepBarrier Operations
+    /**
+     * @brief Waits until every thread of the group reaches the barrier
+     */
+    void wait() {
+        unsigned long long current = this->generation.load(std::memory_order_acquire);
+        if (this->waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == this->count) {
+            this->waiting.store(0, std::memory_order_relaxed);
+            this->generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+        while (this->generation.load(std::memory_order_acquire) == current) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+/**
+ * @brief Counts and samples the words of a given length that a DFA accepts. The count of the words of length m accepted from every state is a vector, and the vector of m + 1 is found from the one of m in a single pass over a flat table of the minimal DFA: every state adds up the counts of its successors, each weighted by the number of symbols that lead there. The passes reuse the same buffers, have no branches and are split among threads by ranges of states, so lengths in the millions take linear time and constant memory. Exact counts are kept modulo a prime, and the magnitude of the count and the sampling use floating point counts scaled by a power of two at every step
+ */
+class WordCounter {
+private:
+    int state_count;
+    int class_count;
+    int initial;
+    int thread_count;
+    std::vector<int> next;
+    std::vector<unsigned int> weights;
+    std::vector<std::vector<int>> class_symbols;
+    std::vector<std::string> symbols;
+    std::vector<unsigned char> accepting;
+
+    /**
+     * @brief Runs steps of the counting, each thread on its own range of states, waiting for each other between two steps
+     * 
+     * @param steps The number of steps
+     * @param step Computes step m of a range of states: step(thread, begin, end, m)
+     */
+    void runSteps(unsigned long long steps, const std::function<void(int, int, int, unsigned long long)>& step) const {
+        int threads = std::max(1, std::min(this->thread_count, this->state_count / COUNT_PARALLEL_MIN_STATES));
+        if (threads == 1) {
+            for (unsigned long long m = 0; m < steps; m++) {
+                step(0, 0, this->state_count, m);
+            }
+            return;
+        }
+        StepBarrier barrier = StepBarrier(threads);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.push_back(std::thread([&, t]() {
+                int begin = (int) ((long long) this->state_count * t / threads);
+                int end = (int) ((long long) this->state_count * (t + 1) / threads);
+                for (unsigned long long m = 0; m < steps; m++) {
+                    step(t, begin, end, m);
+                    barrier.wait();
+                }
+            }));
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief Advances the floating point counts, scaling every new vector by the power of two that brings the largest count of the previous one into [0.5, 1)
+     * 
+     * @param rows The vectors, the first one already filled. Vector m is at rows + m * state_count when keep_all is set, and at rows + (m % 2) * state_count otherwise
+     * @param steps The number of steps
+     * @param keep_all Whether every vector is kept or only the last two
+     * @return The exponent of the scaling of the last vector: its true counts are its values times 2 to this exponent, relative to the first one
+     */
+    long long advanceScaled(double* rows, unsigned long long steps, bool keep_all) const {
+        int n = this->state_count;
+        int threads = std::max(1, std::min(this->thread_count, n / COUNT_PARALLEL_MIN_STATES));
+        std::vector<double> maxima((size_t) 2 * threads, 0.0);
+        for (int s = 0; s < n; s++) {
+            maxima[0] = std::max(maxima[0], rows[s]);
+        }
+        long long exponent = 0;
+        this->runSteps(steps, [&](int t, int begin, int end, unsigned long long m) {
+            const double* in = rows + (keep_all ? m : m % 2) * n;
+            double* out = rows + (keep_all ? m + 1 : (m + 1) % 2) * n;
+            double largest = 0.0;
+            for (int i = 0; i < threads; i++) {
+                largest = std::max(largest, maxima[(m % 2) * threads + i]);
+            }
+            int e = 0;
+            if (largest > 0.0) {
+                std::frexp(largest, &e);
+            }
+            if (t == 0) {
+                exponent += e;
+            }
+            double scale = std::ldexp(1.0, -e);
+            for (int s = begin; s < end; s++) {
+                out[s] = 0.0;
+            }
+            for (int c = 0; c < this->class_count; c++) {
+                const int* column = this->next.data() + (size_t) c * n;
+                double weight = this->weights[c] * scale;
+                for (int s = begin; s < end; s++) {
+                    out[s] += weight * in[column[s]];
+                }
+            }
+            double partial = 0.0;
+            for (int s = begin; s < end; s++) {
+                partial = std::max(partial, out[s]);
+            }
+            maxima[((m + 1) % 2) * threads + t] = partial;
+        });
+        return exponent;
+    }
+
+public:
+    // Constructors
+    /**
+     * @brief Compiles the minimal DFA of a DFA into a flat table, merging the symbols that lead every state to the same place. The dead state is the last state, its count is always zero
+     * 
+     * @param dfa The DFA
+     * @param thread_count The number of threads, 0 to use one per hardware thread
+     */
+    WordCounter(DFA dfa, int thread_count) {
+        IndexedDFA minimal = minimizeIndexedDfa(IndexedDFA(dfa));
+        int n = minimal.getStateCount();
+        int dead = n;
+        this->state_count = n + 1;
+        this->thread_count = thread_count > 0 ? thread_count : std::max(1, (int) std::thread::hardware_concurrency());
+        this->initial = minimal.getInitialState() == NO_STATE ? dead : minimal.getInitialState();
+        this->symbols = minimal.getSymbols();
+        this->accepting = std::vector<unsigned char>(this->state_count, 0);
+        for (int s = 0; s < n; s++) {
+            this->accepting[s] = minimal.isFinalState(s) ? 1 : 0;
+        }
+
+        // Symbols with the same column of the table form one class, weighted by its number of symbols
+        std::map<std::vector<int>, int> columns;
+        std::vector<int> column(this->state_count);
+        for (int a = 0; a < minimal.getSymbolCount(); a++) {
+            for (int s = 0; s < n; s++) {
+                int t = minimal.transite(s, a);
+                column[s] = t == NO_STATE ? dead : t;
+            }
+            column[dead] = dead;
+            auto it = columns.find(column);
+            if (it == columns.end()) {
+                it = columns.insert(std::make_pair(column, (int) this->weights.size())).first;
+                this->next.insert(this->next.end(), column.begin(), column.end());
+                this->weights.push_back(0);
+                this->class_symbols.push_back(std::vector<int>());
+            }
+            this->weights[it->second]++;
+            this->class_symbols[it->second].push_back(a);
+        }
+        this->class_count = (int) this->weights.size();
+    }
+
+    // WordCounter Operations
+    /**
+     * @brief Counts the accepted words of a length modulo a number
+     * 
+     * @param length The length of the words
+     * @param modulus The modulus, from 1 to 2^32
+     * @return The number of accepted words of that length, modulo the modulus
+     */
+    unsigned long long countWords(unsigned long long length, unsigned long long modulus) const {
+        if (modulus == 0 || modulus > (1ULL << 32)) {
+            throw std::invalid_argument("The modulus must be between 1 and 2^32.");
+        }
+        int n = this->state_count;
+        std::vector<unsigned int> counts((size_t) 2 * n);
+        std::vector<unsigned long long> sums(n);
+        for (int s = 0; s < n; s++) {
+            counts[s] = (unsigned int) (this->accepting[s] % modulus);
+        }
+        // Every sum is below (number of symbols) * modulus, so it fits in 64 bits and is reduced once per state
+        this->runSteps(length, [&](int, int begin, int end, unsigned long long m) {
+            const unsigned int* in = counts.data() + (m % 2) * n;
+            unsigned int* out = counts.data() + ((m + 1) % 2) * n;
+            unsigned long long* sum = sums.data();
+            for (int s = begin; s < end; s++) {
+                sum[s] = 0;
+            }
+            for (int c = 0; c < this->class_count; c++) {
+                const int* column = this->next.data() + (size_t) c * n;
+                unsigned long long weight = this->weights[c];
+                for (int s = begin; s < end; s++) {
+                    sum[s] += weight * in[column[s]];
+                }
+            }
+            for (int s = begin; s < end; s++) {
+                out[s] = (unsigned int) (sum[s] % modulus);
+            }
+        });
+        return counts[(length % 2) * n + this->initial];
+    }
+
+    /**
+     * @brief Computes the base 2 logarithm of the number of accepted words of a length, for counts too large to be written
+     * 
+     * @param length The length of the words
+     * @return The logarithm, or -infinity if no word of that length is accepted
+     */
+    double countWordsLog2(unsigned long long length) const {
+        int n = this->state_count;
+        std::vector<double> rows((size_t) 2 * n);
+        for (int s = 0; s < n; s++) {
+            rows[s] = this->accepting[s];
+        }
+        long long exponent = this->advanceScaled(rows.data(), length, false);
+        double count = rows[(length % 2) * n + this->initial];
+        return count > 0.0 ? std::log2(count) + exponent : -INFINITY;
+    }
+
+    /**
+     * @brief Draws accepted words of a length uniformly at random. Every symbol is drawn with a probability proportional to the number of accepted words that go on with it, using floating point counts, so the words are uniform up to rounding. The count vectors are rebuilt in blocks of about the square root of the length from vectors saved at the start of each block, so the memory grows with the square root of the length instead of the length
+     * 
+     * @param length The length of the words
+     * @param count The number of words
+     * @param seed The seed of the random generator
+     * @return The words, as their symbols
+     */
+    std::vector<std::vector<std::string>> sampleWords(unsigned long long length, int count, unsigned long long seed) const {
+        int n = this->state_count;
+        unsigned long long block = std::max(1ULL, (unsigned long long) std::sqrt((double) length));
+        unsigned long long block_count = length / block + 1;
+
+        // Forward pass, saving the vector at the start of every block
+        std::vector<double> checkpoints((size_t) block_count * n);
+        std::vector<double> rows((size_t) (block + 1) * n);
+        for (int s = 0; s < n; s++) {
+            checkpoints[s] = this->accepting[s];
+        }
+        unsigned long long last_block = 0;
+        for (unsigned long long j = 0; j * block < length; j++) {
+            std::copy(checkpoints.begin() + j * n, checkpoints.begin() + (j + 1) * n, rows.begin());
+            unsigned long long steps = std::min(block, length - j * block);
+            this->advanceScaled(rows.data(), steps, true);
+            if (j + 1 < block_count) {
+                std::copy(rows.begin() + steps * n, rows.begin() + (steps + 1) * n, checkpoints.begin() + (j + 1) * n);
+            }
+            last_block = j;
+        }
+        double total = length == 0 ? checkpoints[this->initial] : rows[(length - last_block * block) * n + this->initial];
+        if (total <= 0.0) {
+            throw std::runtime_error("The DFA accepts no word of length " + std::to_string(length) + ".");
+        }
+
+        // Backward pass: the symbol at position i is drawn from the counts of the length - i - 1 symbols left
+        std::mt19937_64 generator(seed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::vector<std::vector<std::string>> words(count);
+        std::vector<int> current(count, this->initial);
+        std::vector<double> chances(this->class_count);
+        for (std::vector<std::string>& word : words) {
+            word.reserve(length);
+        }
+        for (long long j = (long long) last_block; length > 0 && j >= 0; j--) {
+            unsigned long long first = j * block;
+            unsigned long long steps = std::min(block, length - first);
+            if (j != (long long) last_block) {
+                std::copy(checkpoints.begin() + j * n, checkpoints.begin() + (j + 1) * n, rows.begin());
+                this->advanceScaled(rows.data(), steps, true);
+            }
+            for (unsigned long long m = first + steps; m-- > first;) {
+                const double* row = rows.data() + (m - first) * n;
+                for (int w = 0; w < count; w++) {
+                    int s = current[w];
+                    double sum = 0.0;
+                    int chosen = -1;
+                    for (int c = 0; c < this->class_count; c++) {
+                        chances[c] = this->weights[c] * row[this->next[(size_t) c * n + s]];
+                        sum += chances[c];
+                    }
+                    double target = uniform(generator) * sum;
+                    for (int c = 0; c < this->class_count; c++) {
+                        if (chances[c] > 0.0) {
+                            chosen = c;
+                            target -= chances[c];
+                            if (target < 0.0) {
+                                break;
+                            }
+                        }
+                    }
+                    const std::vector<int>& members = this->class_symbols[chosen];
+                    words[w].push_back(this->symbols[members[std::uniform_int_distribution<size_t>(0, members.size() - 1)(generator)]]);
+                    current[w] = this->next[(size_t) chosen * n + s];
+                }
+            }
+        }
+        return words;
+    }
+
+    // WordCounter Information
+    /**
+     * @brief Gets the number of states of the minimal DFA, the dead state included
+     * 
+     * @return The number of states
+     */
+    int getStateCount() const {
+        return this->state_count;
+    }
+
+    /**
+     * @brief Gets the number of classes of symbols
+     * 
+     * @return The number of columns of the table
+     */
+    int getClassCount() const {
+        return this->class_count;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,2 @@
+g++ -o Code/tests Code/tests.cpp Code/pugixml/pugixml.cpp
+./Code/tests
\ No newline at end of file